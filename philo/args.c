@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   args.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:20:17 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:26:08 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Initializes the waiter mutex and the monitor the referee sleeps on, whose
+ * timed waits are on CLOCK_MONOTONIC like the rest of the simulation,
+ * and closes the start gate.
+ * Returns false if any of the initializations fails, else true.
+ */
+static bool	init_locks(t_shared *info)
+{
+	pthread_condattr_t	attr;
+
+	if (pthread_mutex_init(&info->waiter, NULL))
+		return (false);
+	if (pthread_mutex_init(&info->monitor.mutex, NULL))
+		return (false);
+	if (pthread_condattr_init(&attr)
+		|| pthread_condattr_setclock(&attr, CLOCK_MONOTONIC)
+		|| pthread_cond_init(&info->monitor.wakeup, &attr))
+		return (false);
+	pthread_condattr_destroy(&attr);
+	atomic_init(&info->start_gate, 0);
+	info->monitor.heap = NULL;
+	info->monitor.deadlines = NULL;
+	info->profiles = NULL;
+	info->grants = NULL;
+	info->monitor.all_full = false;
+	return (true);
+}
+
+/*
+ * Initializes the shared info struct with the valid input.
+ * If the number of philosophers or number of meals is zero or
+ * if any of the mutex initializations fails, false is returned, 
+ * else true is returned signifying that the initialization was done
+ * successfully.
+ */
+static bool	init_args(t_shared *info, char **argv)
+{
+	info->num_philos = ft_atoi(argv[0]);
+	if (info->num_philos == 0)
+		return (false);
+	info->time_to_die = ms_to_us(argv[1]);
+	info->time_to_eat = ms_to_us(argv[2]);
+	info->time_to_sleep = ms_to_us(argv[3]);
+	if (argv[4])
+	{
+		info->num_meals = ft_atoi(argv[4]);
+		if (!info->num_meals)
+			return (false);
+	}
+	else
+		info->num_meals = -1;
+	atomic_init(&info->ate_max_meal, 0);
+	info->sim_start_time = get_time_us();
+	info->coarse_slack = get_coarse_slack_us();
+	info->virtual_now = info->sim_start_time;
+	if (!info->sim_start_time || !init_locks(info))
+		return (false);
+	atomic_init(&info->stop_epoch, RUNNING);
+	info->table = NULL;
+	info->pool = NULL;
+	info->cpus = NULL;
+	return (true);
+}
+
+/*
+ * Checks if the inputs are non numerical, since any value entered
+ * must be a positive value, the char '-' is considered as an error,
+ * and false is returned. The three times (argv[1] to argv[3]) may have
+ * one decimal point, they are milliseconds with microsecond resolution.
+ * If everything is fine after calling the init_args function, true
+ * is returned.
+ */
+bool	check_args_and_init(char **argv, t_shared *info)
+{
+	int		i;
+	int		dots;
+	char	*args;
+
+	i = 0;
+	while (argv[i])
+	{
+		args = argv[i];
+		dots = 0;
+		if (*args == '+')
+			args++;
+		while (*args)
+		{
+			if (*args == '.' && i >= 1 && i <= 3 && !dots++)
+				args++;
+			else if ('0' > *args || *args > '9')
+				return (false);
+			else
+				args++;
+		}
+		i++;
+	}
+	if (!init_args(info, argv))
+		return (false);
+	return (true);
+}
@@ -0,0 +1,164 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:21:47 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:21:47 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+static const char	*g_outcomes[] = {"running", "died", "full", "error",
+	"time_up"};
+
+/*
+ * Keeps the line as the arguments of the next table, it is set to NULL
+ * so getline allocates the next one. The results grow by doubling.
+ * Returns 0 if malloc fails, else 1.
+ */
+static int	keep_line(t_batch *batch, char **line, unsigned int number)
+{
+	t_result	*bigger;
+
+	if (batch->num_lines == batch->max_lines)
+	{
+		bigger = malloc(sizeof(t_result) * (batch->max_lines * 2 + 16));
+		if (!bigger)
+			return (0);
+		if (batch->num_lines)
+			memcpy(bigger, batch->results,
+				sizeof(t_result) * batch->num_lines);
+		free(batch->results);
+		batch->results = bigger;
+		batch->max_lines = batch->max_lines * 2 + 16;
+	}
+	memset(&batch->results[batch->num_lines], 0, sizeof(t_result));
+	batch->results[batch->num_lines].text = *line;
+	batch->results[batch->num_lines++].line = number;
+	*line = NULL;
+	return (1);
+}
+
+/*
+ * Reads the file, every line holds the arguments of a table, the same
+ * four or five numbers main takes. Empty lines and lines starting with
+ * '#' are skipped, the results still tell the line they come from.
+ * Returns 0 if the file cannot be read or malloc fails, else 1.
+ */
+static int	read_lines(t_batch *batch, const char *path)
+{
+	FILE			*file;
+	char			*line;
+	size_t			size;
+	unsigned int	number;
+	size_t			blank;
+	int				ok;
+
+	file = fopen(path, "r");
+	if (!file)
+		return (0);
+	line = NULL;
+	size = 0;
+	number = 0;
+	ok = 1;
+	while (ok && getline(&line, &size, file) > 0)
+	{
+		number++;
+		blank = strspn(line, " \t\n");
+		if (line[blank] && line[blank] != '#')
+			ok = keep_line(batch, &line, number);
+	}
+	free(line);
+	fclose(file);
+	return (ok);
+}
+
+/*
+ * Marks the result as done and prints every result that is done, in the
+ * order of the file, so the first table holds back the lines of the ones
+ * after it until it ran. A line is "<line> <outcome> <time> <meals>", the
+ * time in milliseconds since the start of the table.
+ */
+void	publish_result(t_batch *batch, t_result *result)
+{
+	t_result	*next;
+
+	pthread_mutex_lock(&batch->print);
+	result->done = true;
+	while (batch->printed < batch->num_lines
+		&& batch->results[batch->printed].done)
+	{
+		next = &batch->results[batch->printed++];
+		printf("%u %s %ld %ld\n", next->line, g_outcomes[next->outcome],
+			next->time / 1000, next->meals);
+	}
+	pthread_mutex_unlock(&batch->print);
+}
+
+/*
+ * The calling thread is the first runner, it makes the other ones and
+ * runs tables with them, then joins them. If a runner cannot be made the
+ * ones already made share the tables. There are never more runners than
+ * tables.
+ */
+static void	run_runners(t_batch *batch, t_runner *runners, unsigned int count)
+{
+	unsigned int	made;
+
+	if (count > batch->num_lines && batch->num_lines)
+		count = batch->num_lines;
+	made = 1;
+	while (made < count)
+	{
+		runners[made].batch = batch;
+		if (pthread_create(&runners[made].thread_id, NULL, runner_routine,
+				&runners[made]))
+			break ;
+		made++;
+	}
+	runners[0].batch = batch;
+	runner_routine(&runners[0]);
+	while (--made > 0)
+		pthread_join(runners[made].thread_id, NULL);
+}
+
+/*
+ * --batch: runs every table of the file, each one on its own t_shared,
+ * up to --workers of them at the same time. A table runs on the virtual
+ * clock, so it does not matter how many of them share the CPUs, a run
+ * gives the same result alone or in a batch. Instead of the events, every
+ * table prints a single line, see publish_result.
+ * Returns 1 if the batch cannot be read, else 0.
+ */
+int	run_batch(t_options *opt)
+{
+	t_batch		batch;
+	t_runner	*runners;
+	int			status;
+
+	memset(&batch, 0, sizeof(t_batch));
+	batch.opt = *opt;
+	batch.opt.workers = 1;
+	atomic_init(&batch.next, 0);
+	runners = NULL;
+	if (read_lines(&batch, opt->batch)
+		&& !pthread_mutex_init(&batch.print, NULL))
+		runners = calloc(opt->workers, sizeof(t_runner));
+	status = (runners == NULL);
+	if (runners)
+	{
+		run_runners(&batch, runners, opt->workers);
+		pthread_mutex_destroy(&batch.print);
+	}
+	else
+		printf("Error: Cannot run the batch file.\n");
+	free(runners);
+	while (batch.printed < batch.num_lines)
+		free(batch.results[batch.printed++].text);
+	free(batch.results);
+	return (status);
+}
@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   batch_run.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:21:34 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:41:22 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Splits the line in place at blanks into the numbers of a table, argv
+ * ends with NULL like the one of main. Returns false unless there are
+ * four or five of them.
+ */
+static bool	split_line(char *line, char **argv)
+{
+	int	count;
+
+	count = 0;
+	while (*line)
+	{
+		while (*line == ' ' || *line == '\t' || *line == '\n')
+			*line++ = '\0';
+		if (!*line)
+			break ;
+		if (count == 5)
+			return (false);
+		argv[count++] = line;
+		while (*line && *line != ' ' && *line != '\t' && *line != '\n')
+			line++;
+	}
+	argv[count] = NULL;
+	return (count >= 4);
+}
+
+/*
+ * The seats of the runner are reused when the table fits in them, else
+ * they are freed and make_table allocates room for this table, which the
+ * runner keeps for the next ones. If make_table fails it frees them.
+ * Returns 0 if it fails, else 1.
+ */
+static int	lay_table(t_runner *runner, t_shared *info)
+{
+	if (info->num_philos <= runner->capacity)
+	{
+		info->table = runner->table;
+		info->monitor.heap = runner->heap;
+	}
+	else
+	{
+		free(runner->table);
+		free(runner->heap);
+		runner->capacity = info->num_philos;
+	}
+	runner->table = make_table(info);
+	runner->heap = info->monitor.heap;
+	if (!runner->table)
+		runner->capacity = 0;
+	return (runner->table != NULL);
+}
+
+/*
+ * The meals every seat finished, a meal still going on when the table
+ * stopped is not counted.
+ */
+static long	count_meals(t_shared *info)
+{
+	long			meals;
+	unsigned int	i;
+
+	meals = 0;
+	i = 0;
+	while (i < info->num_philos)
+		meals += atomic_load_explicit(&info->table[i++].times_eaten,
+				memory_order_relaxed);
+	return (meals);
+}
+
+/*
+ * Runs the table of the result like main would with --virtual-time, but
+ * without a writer, nothing is printed until the table stopped. A table
+ * without a number of meals stops at BATCH_HORIZON at the latest, unless
+ * --horizon is given. The outcome stays SIM_ERROR if the line is not
+ * valid or anything fails.
+ */
+static void	run_table(t_runner *runner, t_result *result)
+{
+	t_shared	info;
+	char		*argv[6];
+
+	result->outcome = SIM_ERROR;
+	info.opt = runner->batch->opt;
+	if (!split_line(result->text, argv) || !check_args_and_init(argv, &info))
+		return ;
+	info.writer = NULL;
+	info.shm = NULL;
+	if (!info.opt.horizon && info.num_meals == -1)
+		info.opt.horizon = BATCH_HORIZON;
+	if (!lay_table(runner, &info))
+		return ;
+	if (STATS_INIT(&info) && setup_pool(&info))
+	{
+		run_virtual_time(&info);
+		free_pool(&info);
+		result->outcome = atomic_load(&info.stop_epoch);
+		result->time = info.virtual_now - info.sim_start_time;
+		result->meals = count_meals(&info);
+	}
+	clear_table(&info);
+}
+
+/*
+ * A runner takes the next table that nobody took yet, until there is
+ * none left. Its thread and its seats serve one table after the other.
+ */
+void	*runner_routine(void *arg)
+{
+	t_runner		*runner;
+	t_batch			*batch;
+	unsigned int	i;
+
+	runner = (t_runner *)arg;
+	batch = runner->batch;
+	i = atomic_fetch_add(&batch->next, 1);
+	while (i < batch->num_lines)
+	{
+		run_table(runner, &batch->results[i]);
+		free(batch->results[i].text);
+		batch->results[i].text = NULL;
+		publish_result(batch, &batch->results[i]);
+		i = atomic_fetch_add(&batch->next, 1);
+	}
+	free(runner->table);
+	free(runner->heap);
+	return (NULL);
+}
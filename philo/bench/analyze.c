@@ -0,0 +1,176 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   analyze.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:40:01 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:54:16 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+
+/*
+ * analyze reads the output of a philo run on stdin and prints one CSV
+ * fragment on stdout:
+ *   meals,meals_per_s,interval_p50_ms,interval_p99_ms,interval_max_ms,
+ *   eaten_min,eaten_max,fairness_spread,end,death_latency_ms
+ * meals_per_s is over the simulated time, up to the last timestamp.
+ * An interval is the time between two meals of the same seat, the
+ * longest one is the worst hunger any seat went through. The
+ * fairness spread is eaten_max - eaten_min across all seats. The death
+ * latency is how late "died." came after the starving seat's deadline,
+ * his last meal plus time_to_die, it is empty if nobody died.
+ *
+ *   cc -O2 -o analyze bench/analyze.c
+ *   ./philo 5 800 200 200 10 | ./analyze 5 800
+ */
+
+typedef struct s_stats
+{
+	unsigned int	num_philos;
+	long			time_to_die;
+	long			*last_meal;
+	int				*eaten;
+	long			*intervals;
+	size_t			num_intervals;
+	size_t			max_intervals;
+	long			meals;
+	long			last_time;
+	long			died_time;
+	unsigned int	died_id;
+	bool			full;
+}					t_stats;
+
+static int	record_meal(t_stats *stats, unsigned int id, long time)
+{
+	long	*bigger;
+
+	if (stats->eaten[id - 1] && stats->num_intervals == stats->max_intervals)
+	{
+		stats->max_intervals = stats->max_intervals * 2 + 1024;
+		bigger = realloc(stats->intervals, sizeof(long)
+				* stats->max_intervals);
+		if (!bigger)
+			return (0);
+		stats->intervals = bigger;
+	}
+	if (stats->eaten[id - 1])
+		stats->intervals[stats->num_intervals++]
+			= time - stats->last_meal[id - 1];
+	stats->last_meal[id - 1] = time;
+	stats->eaten[id - 1]++;
+	stats->meals++;
+	return (1);
+}
+
+static int	read_line(t_stats *stats, const char *line)
+{
+	long			time;
+	unsigned int	id;
+	char			state[64];
+
+	if (!strncmp(line, "All philos", 10))
+		stats->full = true;
+	if (sscanf(line, "%ld %u %63[^\n]", &time, &id, state) != 3
+		|| id == 0 || id > stats->num_philos)
+		return (1);
+	stats->last_time = time;
+	if (!strcmp(state, "died."))
+	{
+		stats->died_id = id;
+		stats->died_time = time;
+	}
+	if (!strcmp(state, "is eating."))
+		return (record_meal(stats, id, time));
+	return (1);
+}
+
+static int	compare_long(const void *a, const void *b)
+{
+	long	x;
+	long	y;
+
+	x = *(const long *)a;
+	y = *(const long *)b;
+	return ((x > y) - (x < y));
+}
+
+static void	eaten_range(t_stats *stats, int *min, int *max)
+{
+	unsigned int	i;
+
+	*min = stats->eaten[0];
+	*max = stats->eaten[0];
+	i = 0;
+	while (++i < stats->num_philos)
+	{
+		if (stats->eaten[i] < *min)
+			*min = stats->eaten[i];
+		if (stats->eaten[i] > *max)
+			*max = stats->eaten[i];
+	}
+}
+
+static void	print_row(t_stats *stats)
+{
+	int		min;
+	int		max;
+	size_t	n;
+	double	rate;
+
+	eaten_range(stats, &min, &max);
+	n = stats->num_intervals;
+	qsort(stats->intervals, n, sizeof(long), compare_long);
+	rate = 0;
+	if (stats->last_time)
+		rate = stats->meals * 1000.0 / stats->last_time;
+	printf("%ld,%.1f,", stats->meals, rate);
+	if (n)
+		printf("%ld,%ld,%ld,", stats->intervals[(n - 1) / 2],
+			stats->intervals[(n - 1) * 99 / 100], stats->intervals[n - 1]);
+	else
+		printf(",,,");
+	printf("%d,%d,%d,", min, max, max - min);
+	if (stats->died_id)
+		printf("died,%ld\n", stats->died_time - stats->time_to_die
+			- stats->last_meal[stats->died_id - 1]);
+	else if (stats->full)
+		printf("full,\n");
+	else
+		printf("none,\n");
+}
+
+int	main(int argc, char **argv)
+{
+	t_stats	stats;
+	char	*line;
+	size_t	size;
+
+	if (argc != 3 || atoi(argv[1]) <= 0)
+	{
+		fprintf(stderr, "usage: %s num_philos time_to_die_ms\n", argv[0]);
+		return (2);
+	}
+	memset(&stats, 0, sizeof(t_stats));
+	stats.num_philos = atoi(argv[1]);
+	stats.time_to_die = atol(argv[2]);
+	stats.last_meal = calloc(stats.num_philos, sizeof(long));
+	stats.eaten = calloc(stats.num_philos, sizeof(int));
+	line = NULL;
+	size = 0;
+	if (!stats.last_meal || !stats.eaten)
+		return (1);
+	while (getline(&line, &size, stdin) > 0)
+		if (!read_line(&stats, line))
+			return (1);
+	print_row(&stats);
+	free(line);
+	return (0);
+}
@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   clock_bench.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:07:48 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:07:48 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <sys/time.h>
+#include <time.h>
+
+/*
+ * clock_bench measures the cost of one call of every clock the
+ * simulation could read its time from.
+ *
+ *   cc -O2 -o clock_bench bench/clock_bench.c && ./clock_bench
+ */
+
+#define CALLS 5000000
+
+static double	elapsed_ns(struct timespec *a, struct timespec *b)
+{
+	return ((b->tv_sec - a->tv_sec) * 1e9 + (b->tv_nsec - a->tv_nsec));
+}
+
+static void	bench_clock(const char *name, clockid_t id)
+{
+	struct timespec	start;
+	struct timespec	end;
+	struct timespec	now;
+	struct timespec	res;
+	long			i;
+
+	clock_getres(id, &res);
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	i = 0;
+	while (i++ < CALLS)
+		clock_gettime(id, &now);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	printf("%-26s %8.1f ns/call   resolution %ld ns\n", name,
+		elapsed_ns(&start, &end) / CALLS, res.tv_sec * 1000000000L
+		+ res.tv_nsec);
+}
+
+static void	bench_gettimeofday(void)
+{
+	struct timespec	start;
+	struct timespec	end;
+	struct timeval	now;
+	long			i;
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	i = 0;
+	while (i++ < CALLS)
+		gettimeofday(&now, NULL);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	printf("%-26s %8.1f ns/call   resolution 1000 ns\n", "gettimeofday",
+		elapsed_ns(&start, &end) / CALLS);
+}
+
+int	main(void)
+{
+	bench_gettimeofday();
+	bench_clock("CLOCK_REALTIME", CLOCK_REALTIME);
+	bench_clock("CLOCK_MONOTONIC", CLOCK_MONOTONIC);
+	bench_clock("CLOCK_MONOTONIC_COARSE", CLOCK_MONOTONIC_COARSE);
+	bench_clock("CLOCK_MONOTONIC_RAW", CLOCK_MONOTONIC_RAW);
+	bench_clock("CLOCK_BOOTTIME", CLOCK_BOOTTIME);
+	return (0);
+}
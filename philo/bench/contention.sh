@@ -0,0 +1,21 @@
+#!/bin/sh
+# Counts mutex acquisitions per second of a philo binary at 200, 1000
+# and 5000 philosophers. The binary is rebuilt without the thread
+# sanitizer so the preloaded counter sees the plain pthread calls.
+#
+# usage: bench/contention.sh [seconds]   (run from the philo directory)
+
+SECONDS_PER_RUN=${1:-5}
+OUT=${BENCH_DIR:-/tmp/philo_bench}
+
+mkdir -p "$OUT"
+cc -O2 -pthread -o "$OUT/philo" *.c || exit 1
+cc -O2 -shared -fPIC -o "$OUT/lock_count.so" bench/lock_count.c -ldl \
+	|| exit 1
+for n in 200 1000 5000
+do
+	printf "%6d philos: " "$n"
+	LD_PRELOAD="$OUT/lock_count.so" LOCK_COUNT_SECONDS="$SECONDS_PER_RUN" \
+		"$OUT/philo" "$n" 100000 100 100 2>&1 >/dev/null \
+		| grep lock_count
+done
@@ -0,0 +1,28 @@
+#!/bin/sh
+# Reports the voluntary context switches per philosopher-second and the
+# CPU time of the event driven sleeps against the --poll-sleep ones.
+# Every run is time_to_die 100000, time_to_eat and time_to_sleep 200,
+# ending after 10 meals, so almost all of it is spent sleeping.
+#
+# usage: bench/ctx_switches.sh [philos...]   (run from the philo directory)
+
+OUT=${BENCH_DIR:-/tmp/philo_bench}
+PHILOS=${*:-10 100 1000}
+
+mkdir -p "$OUT"
+cc -O2 -pthread -o "$OUT/philo" *.c || exit 1
+cc -O2 -o "$OUT/rusage_run" bench/rusage_run.c || exit 1
+printf "%-8s %-8s %12s %10s %10s\n" mode philos "nvcsw/ph/s" "cpu s" "wall s"
+for n in $PHILOS
+do
+	for mode in "" --poll-sleep
+	do
+		line=$("$OUT/rusage_run" "$OUT/philo" $mode "$n" 100000 200 200 10 \
+			2>&1 >/dev/null | grep '^wall=')
+		echo "$line" | awk -v n="$n" -v mode="$([ -n "$mode" ] && echo poll || echo event)" '{
+			for (i = 1; i <= NF; i++) { split($i, kv, "="); v[kv[1]] = kv[2] }
+			printf "%-8s %-8d %12.2f %10.3f %10.3f\n", mode, n,
+				v["nvcsw"] / (n * v["wall"]), v["user"] + v["sys"], v["wall"]
+		}'
+	done
+done
@@ -0,0 +1,76 @@
+#!/bin/sh
+# The check behind "make death". For every monitor, table size and
+# time_to_die:time_to_eat:time_to_sleep it plants a seat that starves,
+# the second one, one in the middle and the last one in turn: a profile
+# gives it a time_to_sleep longer than time_to_die, so it dies asleep
+# after its first meal while everybody else could eat forever. The log
+# goes through validate, which fails a "died." line later than 10ms
+# after the deadline or any seat going on unseen past its own, and the
+# dead seat must be the planted one. One line per run:
+#   monitor philos timing victim died latency_ms ok|late|FAIL
+# The exit status is 1 if any run failed. The binaries are expected in
+# BENCH_DIR.
+#
+# The 10ms only hold while the referee gets a CPU as soon as his timer
+# fires, see main_thread.c. A table with more seats than the machine has
+# CPUs can have more philosophers runnable than CPUs at the deadline,
+# the referee then waits for the scheduler. Such a table is "late"
+# instead of failing when all validate has against it is lateness, the
+# wrong seat dying still fails. bench/latency.sh checks the bound where
+# it holds.
+#
+# usage: make death [PHILOS="5 50 200"] [TIMINGS="800:200:200"]
+#        [MONITORS="heap sweep"]
+
+OUT=${BENCH_DIR:-bench_build}
+PHILOS=${PHILOS:-5 50 200}
+TIMINGS=${TIMINGS:-800:200:200 410:100:100}
+MONITORS=${MONITORS:-heap sweep}
+CPUS=$(getconf _NPROCESSORS_ONLN)
+failed=0
+
+for monitor in $MONITORS
+do
+	for n in $PHILOS
+	do
+		for timing in $TIMINGS
+		do
+			set -- $(echo "$timing" | tr ':' ' ')
+			for victim in 2 $((n / 2 + 1)) "$n"
+			do
+				echo "$victim $1 $2 $(($1 + 100))" > "$OUT/victim.profile"
+				"$OUT/philo" --monitor="$monitor" \
+					--profile="$OUT/victim.profile" "$n" "$1" "$2" "$3" \
+					>"$OUT/out" 2>/dev/null
+				died=$(grep 'died\.$' "$OUT/out" | awk '{ print $2 }')
+				latency=$("$OUT/analyze" "$n" "$1" < "$OUT/out" \
+					| awk -F, '{ print $10 }')
+				"$OUT/validate" -f "$OUT/out" "$n" "$1" "$2" "$3" \
+					>"$OUT/violations" 2>/dev/null
+				valid=$?
+				result=ok
+				if [ $valid -ne 0 ] && [ "$n" -gt "$CPUS" ] \
+					&& ! grep -qv 'ms late$\|should have died' \
+					"$OUT/violations"
+				then
+					result=late
+				elif [ $valid -ne 0 ]
+				then
+					result=FAIL
+				fi
+				if [ "$died" != "$victim" ]
+				then
+					result=FAIL
+				fi
+				if [ $result = FAIL ]
+				then
+					failed=1
+					cat "$OUT/violations"
+				fi
+				echo "$monitor $n $timing $victim ${died:-none}" \
+					"${latency:-none} $result"
+			done
+		done
+	done
+done
+exit $failed
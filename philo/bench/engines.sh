@@ -0,0 +1,43 @@
+#!/bin/sh
+# Compares the thread per philosopher engine with the pool: seats per GB
+# of resident memory and meals per second. Every run is time_to_die 800,
+# time_to_eat and time_to_sleep 200, ending after MEALS meals each.
+# Tables larger than THREADS_MAX are only run on the pool, a thread per
+# seat does not get that far (the thread limit, or it starves first).
+#
+# usage: bench/engines.sh [philos...]   (run from the philo directory)
+#        MEALS=10 THREADS_MAX=10000 WORKERS=<cpus>
+
+OUT=${BENCH_DIR:-/tmp/philo_bench}
+PHILOS=${*:-1000 10000 100000}
+MEALS=${MEALS:-10}
+THREADS_MAX=${THREADS_MAX:-10000}
+WORKERS=${WORKERS:-$(nproc)}
+
+mkdir -p "$OUT"
+cc -O2 -pthread -o "$OUT/philo" *.c || exit 1
+cc -O2 -o "$OUT/rusage_run" bench/rusage_run.c || exit 1
+printf "%-8s %-8s %10s %12s %12s %10s %s\n" engine philos "wall s" \
+	"maxrss MB" "seats/GB" "meals/s" end
+for n in $PHILOS
+do
+	for engine in threads pool
+	do
+		if [ "$engine" = threads ] && [ "$n" -gt "$THREADS_MAX" ]
+		then
+			printf "%-8s %-8d %10s %12s %12s %10s\n" "$engine" "$n" - - - -
+			continue
+		fi
+		"$OUT/rusage_run" "$OUT/philo" --engine=$engine --workers=$WORKERS \
+			"$n" 800 200 200 "$MEALS" 2>"$OUT/usage" >"$OUT/out"
+		meals=$(grep -c "is eating" "$OUT/out")
+		end=$(tail -1 "$OUT/out" | grep -q died && echo died || echo full)
+		grep '^wall=' "$OUT/usage" | awk -v n="$n" -v e="$engine" \
+			-v m="$meals" -v end="$end" '{
+			for (i = 1; i <= NF; i++) { split($i, kv, "="); v[kv[1]] = kv[2] }
+			printf "%-8s %-8d %10.3f %12.1f %12.0f %10.0f %s\n", e, n,
+				v["wall"], v["maxrss_kb"] / 1024,
+				n / (v["maxrss_kb"] / 1048576), m / v["wall"], end
+		}'
+	done
+done
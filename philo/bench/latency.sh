@@ -0,0 +1,48 @@
+#!/bin/sh
+# The check behind "make latency", it needs nothing but philo and awk.
+# Every case is an even table with time_to_die shorter than time_to_eat:
+# the odd seats eat first and hold the chopsticks past time_to_die, the
+# even seats start 5ms late and never get to eat. They all have the
+# earliest deadline, the start plus time_to_die, an odd seat's is later
+# by the time it took to get its chopsticks, so the first "died." line
+# must be an even seat's, seat 2 of "2 150 200 100", any even seat of
+# the larger tables, never seat 1. The latency is the time of that line
+# minus the seat's last "is eating." (the start if it never ate) and
+# time_to_die, it must be within 10ms. One line per run:
+#   philos time_to_die time_to_eat time_to_sleep died latency_ms ok|FAIL
+# The exit status is 1 if any run failed.
+#
+# Nothing else runs while the referee waits for that deadline, every
+# philosopher is asleep or blocked on a chopstick, which is the case the
+# heap referee is bound for, see main_thread.c.
+#
+# usage: make latency [CASES="2:150:200:100 200:150:200:100"] [RUNS=5]
+
+PHILO=${PHILO:-./philo}
+CASES=${CASES:-2:150:200:100 4:150:200:100 10:310:400:100 200:150:200:100}
+RUNS=${RUNS:-5}
+failed=0
+
+for case in $CASES
+do
+	set -- $(echo "$case" | tr ':' ' ')
+	run=0
+	while [ $run -lt "$RUNS" ]
+	do
+		result=$("$PHILO" "$@" 2>/dev/null | awk -v ttd="$2" '
+			$3 == "is" && $4 == "eating." { meal[$2] = $1 }
+			$3 == "died." {
+				latency = $1 - meal[$2] - ttd
+				ok = $2 % 2 == 0 && latency >= 0 && latency <= 10
+				print $2, latency, ok ? "ok" : "FAIL"
+				exit
+			}')
+		case "$result" in
+			*ok) ;;
+			*) failed=1 ;;
+		esac
+		echo "$* ${result:-none none FAIL}"
+		run=$((run + 1))
+	done
+done
+exit $failed
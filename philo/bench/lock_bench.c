@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lock_bench.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:13:12 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:13:12 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../philo.h"
+
+/*
+ * lock_bench has the two seats of a table of 2 fight over the chopstick
+ * they share, with the pthread mutex and with the ticket lock of
+ * --chopstick-lock=ticket. Each seat takes it, holds it for time_to_eat
+ * (sub-millisecond here), puts it down and asks again at once, so every
+ * release is contended. Per lock and hold time it prints:
+ *   takes/s:	how often the chopstick changed hands or not, per second.
+ *   handoffs:	how often it went to the other seat, who was waiting.
+ *   wake avg and p99:	from the release to the waiting seat having it.
+ *   barged:	how often the seat that put it down took it right back
+ *   			while the other was already waiting.
+ *
+ *   cc -O2 -pthread -o lock_bench bench/lock_bench.c \
+ *       $(ls *.c | grep -v '^main.c$')
+ *   ./lock_bench 2
+ */
+
+# define MAX_SAMPLES 1000000
+
+typedef struct s_bench
+{
+	t_shared		info;
+	time_t			end;
+	int				holder;
+	time_t			released;
+	atomic_long		waiting_since[2];
+	long			takes;
+	long			barged;
+	long			num_samples;
+	long			*samples;
+}					t_bench;
+
+static t_bench	g_bench;
+
+/*
+ * Called with the chopstick held, by the seat i.
+ */
+static void	account(int i, time_t waited_from, time_t now)
+{
+	long	other;
+
+	other = atomic_load(&g_bench.waiting_since[1 - i]);
+	if (g_bench.holder == i && other && other < g_bench.released)
+		g_bench.barged++;
+	if (g_bench.holder == 1 - i && waited_from < g_bench.released
+		&& g_bench.num_samples < MAX_SAMPLES)
+		g_bench.samples[g_bench.num_samples++] = now - g_bench.released;
+	g_bench.holder = i;
+	g_bench.takes++;
+}
+
+/*
+ * Seat 1 shares its left chopstick with the right one of seat 2.
+ */
+static void	*seat_routine(void *arg)
+{
+	t_philo	*philo;
+	t_lock	which;
+	int		i;
+	time_t	from;
+
+	philo = arg;
+	i = philo->philo_id - 1;
+	which = LOCK_LEFT + i;
+	while (get_time_us() < g_bench.end)
+	{
+		from = get_time_us();
+		atomic_store(&g_bench.waiting_since[i], from);
+		lock_chopstick(philo, which);
+		atomic_store(&g_bench.waiting_since[i], 0);
+		atomic_store(&philo->last_meal_time, get_time_us());
+		account(i, from, get_time_us());
+		usleep(philo->info->time_to_eat);
+		g_bench.released = get_time_us();
+		unlock_chopstick(philo, which);
+	}
+	return (NULL);
+}
+
+static int	compare_long(const void *a, const void *b)
+{
+	return ((*(const long *)a > *(const long *)b)
+		- (*(const long *)a < *(const long *)b));
+}
+
+static void	run(t_philo *table, t_chopstick_lock lock, time_t hold, int secs)
+{
+	pthread_t	threads[2];
+	double		sum;
+	long		i;
+	const char	*name;
+
+	name = "mutex";
+	if (lock == CHOPSTICK_TICKET)
+		name = "ticket";
+	g_bench.info.opt.chopstick_lock = lock;
+	g_bench.info.time_to_eat = hold;
+	g_bench.holder = -1;
+	g_bench.takes = 0;
+	g_bench.barged = 0;
+	g_bench.num_samples = 0;
+	g_bench.end = get_time_us() + secs * 1000000L;
+	pthread_create(&threads[0], NULL, seat_routine, &table[0]);
+	pthread_create(&threads[1], NULL, seat_routine, &table[1]);
+	pthread_join(threads[0], NULL);
+	pthread_join(threads[1], NULL);
+	qsort(g_bench.samples, g_bench.num_samples, sizeof(long), compare_long);
+	sum = 0;
+	i = 0;
+	while (i < g_bench.num_samples)
+		sum += g_bench.samples[i++];
+	printf("%-7s %7ld %9.0f %9ld %11.1f %7ld %7ld\n", name, hold,
+		(double)g_bench.takes / secs, g_bench.num_samples,
+		sum / (g_bench.num_samples + (g_bench.num_samples == 0)),
+		g_bench.samples[g_bench.num_samples * 99 / 100], g_bench.barged);
+}
+
+int	main(int argc, char **argv)
+{
+	static const time_t	holds[] = {20, 100, 500};
+	t_philo				*table;
+	int					secs;
+	int					i;
+
+	secs = 2;
+	if (argc > 1)
+		secs = atoi(argv[1]);
+	g_bench.info.num_philos = 2;
+	g_bench.samples = malloc(sizeof(long) * MAX_SAMPLES);
+	if (posix_memalign((void **)&table, CACHE_LINE, sizeof(t_philo) * 2
+			+ sizeof(t_chopstick) * 2) || !g_bench.samples || secs <= 0)
+		return (1);
+	memset(table, 0, sizeof(t_philo) * 2 + sizeof(t_chopstick) * 2);
+	g_bench.info.table = table;
+	g_bench.info.chopsticks = (t_chopstick *)(table + 2);
+	i = -1;
+	while (++i < 2)
+	{
+		table[i].philo_id = i + 1;
+		table[i].info = &g_bench.info;
+		init_chopstick(&g_bench.info.chopsticks[i], i + 1);
+	}
+	printf("%-7s %7s %9s %9s %11s %7s %7s\n", "lock", "hold_us", "takes/s",
+		"handoffs", "wake_avg_us", "p99_us", "barged");
+	i = -1;
+	while (++i < 6)
+		run(table, i % 2, holds[i / 2], secs);
+	return (0);
+}
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   lock_count.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:55:10 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 00:55:10 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include <dlfcn.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdatomic.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <unistd.h>
+
+/*
+ * lock_count is preloaded (LD_PRELOAD) into a philo binary built without
+ * the thread sanitizer. It counts every pthread_mutex_lock and trylock call
+ * made by the process, and after LOCK_COUNT_SECONDS (default 5) it prints
+ * the number of acquisitions and the rate per second, then exits.
+ */
+
+static atomic_ulong	g_locks;
+static struct timeval	g_start;
+static int				(*g_real_lock)(pthread_mutex_t *);
+static int				(*g_real_trylock)(pthread_mutex_t *);
+
+static void	print_counts(int sig)
+{
+	struct timeval	now;
+	double			elapsed;
+	unsigned long	locks;
+	char			line[128];
+	int				len;
+
+	(void)sig;
+	gettimeofday(&now, NULL);
+	elapsed = (now.tv_sec - g_start.tv_sec)
+		+ (now.tv_usec - g_start.tv_usec) / 1e6;
+	locks = atomic_load(&g_locks);
+	len = snprintf(line, sizeof(line), "lock_count: %lu acquisitions "
+			"in %.2fs, %.0f/s\n", locks, elapsed, locks / elapsed);
+	write(2, line, len);
+	_exit(0);
+}
+
+__attribute__((constructor))
+static void	lock_count_init(void)
+{
+	char	*seconds;
+
+	g_real_lock = dlsym(RTLD_NEXT, "pthread_mutex_lock");
+	g_real_trylock = dlsym(RTLD_NEXT, "pthread_mutex_trylock");
+	gettimeofday(&g_start, NULL);
+	seconds = getenv("LOCK_COUNT_SECONDS");
+	signal(SIGALRM, print_counts);
+	if (seconds)
+		alarm(atoi(seconds));
+	else
+		alarm(5);
+}
+
+int	pthread_mutex_lock(pthread_mutex_t *mutex)
+{
+	atomic_fetch_add_explicit(&g_locks, 1, memory_order_relaxed);
+	return (g_real_lock(mutex));
+}
+
+int	pthread_mutex_trylock(pthread_mutex_t *mutex)
+{
+	atomic_fetch_add_explicit(&g_locks, 1, memory_order_relaxed);
+	return (g_real_trylock(mutex));
+}
@@ -0,0 +1,6 @@
+# A mixed table for 200 seats, see profile.c:
+#   ./philo --profile=bench/mixed.profile 200 1200 100 100 40
+# Every fourth seat holds its chopsticks three times as long and needs
+# fewer meals, the other seats keep the numbers of the command line.
+# seats      die    eat    sleep  meals
+1-200/4      1200   300    100    20
@@ -0,0 +1,52 @@
+#!/bin/sh
+# Reports meals/s and the cache-line traffic between cores with the
+# threads unpinned, with --pin and with --pin-referee. Every run is
+# time_to_die 800, time_to_eat and time_to_sleep 200, ending after 20
+# meals. The traffic is counted with perf stat when perf is installed:
+# cpu-migrations, cache-misses, and where the CPU has one, the event
+# counting loads served from another core's modified line (HITM), which
+# is what a chopstick changing cores costs. Without perf those columns
+# are n/a.
+#
+# usage: bench/pinning.sh [philos...]   (run from the philo directory)
+
+OUT=${BENCH_DIR:-/tmp/philo_bench}
+PHILOS=${*:-16 64 256}
+
+mkdir -p "$OUT"
+cc -O2 -pthread -o "$OUT/philo" *.c || exit 1
+cc -O2 -o "$OUT/analyze" bench/analyze.c || exit 1
+EVENTS=
+if command -v perf >/dev/null 2>&1
+then
+	HITM=$(perf list 2>/dev/null | grep -io '[a-z0-9_.]*xsnp_hitm[a-z0-9_.]*' \
+		| head -1)
+	EVENTS="cpu-migrations,cache-misses${HITM:+,$HITM}"
+fi
+printf "%-13s %-7s %10s %14s %14s %14s\n" mode philos meals/s migrations \
+	cache-misses hitm
+for n in $PHILOS
+do
+	for mode in none --pin --pin-referee
+	do
+		flag=$mode
+		[ "$mode" = none ] && flag=
+		if [ -n "$EVENTS" ]
+		then
+			perf stat -x, -e "$EVENTS" -o "$OUT/perf" "$OUT/philo" $flag \
+				"$n" 800 200 200 20 > "$OUT/out"
+		else
+			"$OUT/philo" $flag "$n" 800 200 200 20 > "$OUT/out"
+			: > "$OUT/perf"
+		fi
+		rate=$("$OUT/analyze" "$n" 800 < "$OUT/out" | cut -d, -f2)
+		awk -F, -v mode="$mode" -v n="$n" -v rate="$rate" '
+			$3 ~ /migrations/ { m = $1 }
+			$3 ~ /cache-misses/ { c = $1 }
+			$3 ~ /hitm/ { h = $1 }
+			END {
+				printf "%-13s %-7d %10s %14s %14s %14s\n", mode, n, rate,
+					m == "" ? "n/a" : m, c == "" ? "n/a" : c, h == "" ? "n/a" : h
+			}' "$OUT/perf"
+	done
+done
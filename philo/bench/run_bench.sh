@@ -0,0 +1,51 @@
+#!/bin/sh
+# The sweep behind "make bench". For every engine, strategy, number of
+# philosophers and time_to_die:time_to_eat:time_to_sleep it runs the
+# optimized binary until MEALS meals each (or a death), and appends one
+# row to the CSV:
+#   engine,strategy,philos,time_to_die,time_to_eat,time_to_sleep,meals_arg,
+#   wall_s,cpu_s,maxrss_kb,<the columns of bench/analyze.c>
+# The pool only runs the default strategy, other pairs are skipped.
+# The binaries are expected in BENCH_DIR, the Makefile builds them.
+#
+# usage: make bench [BENCH_CSV=file] [PHILOS="5 50"] [TIMINGS="800:200:200"]
+#        [ENGINES="threads pool"] [MEALS=10]
+#        [STRATEGIES="default hierarchy waiter chandy-misra ticket"]
+
+OUT=${BENCH_DIR:-bench_build}
+CSV=${BENCH_CSV:-bench_results.csv}
+PHILOS=${PHILOS:-5 50 200}
+TIMINGS=${TIMINGS:-800:200:200 410:200:200 310:200:100}
+ENGINES=${ENGINES:-threads pool}
+MEALS=${MEALS:-10}
+STRATEGIES=${STRATEGIES:-default}
+
+echo "engine,strategy,philos,time_to_die,time_to_eat,time_to_sleep,\
+meals_arg,wall_s,cpu_s,maxrss_kb,meals,meals_per_s,interval_p50_ms,\
+interval_p99_ms,interval_max_ms,eaten_min,eaten_max,fairness_spread,end,\
+death_latency_ms" > "$CSV"
+for engine in $ENGINES
+do
+	for strategy in $STRATEGIES
+	do
+		[ "$engine" = pool ] && [ "$strategy" != default ] && continue
+		for n in $PHILOS
+		do
+			for timing in $TIMINGS
+			do
+				set -- $(echo "$timing" | tr ':' ' ')
+				"$OUT/rusage_run" "$OUT/philo" --engine="$engine" \
+					--strategy="$strategy" "$n" "$1" "$2" "$3" "$MEALS" \
+					2>"$OUT/usage" >"$OUT/out"
+				usage=$(grep '^wall=' "$OUT/usage" | awk '{
+					for (i = 1; i <= NF; i++) { split($i, kv, "="); v[kv[1]] = kv[2] }
+					printf "%s,%.3f,%s", v["wall"], v["user"] + v["sys"], v["maxrss_kb"]
+				}')
+				row="$engine,$strategy,$n,$1,$2,$3,$MEALS,$usage,$("$OUT/analyze" \
+					"$n" "$1" < "$OUT/out")"
+				echo "$row" >> "$CSV"
+				echo "$row"
+			done
+		done
+	done
+done
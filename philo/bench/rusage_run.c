@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   rusage_run.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:08:50 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:08:50 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <sys/resource.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*
+ * rusage_run runs a command and prints, on stderr, what the kernel
+ * accounted for it as one line of key=value pairs:
+ *   wall=<s> user=<s> sys=<s> nvcsw=<n> nivcsw=<n> maxrss_kb=<n>
+ * nvcsw are the voluntary context switches (the process blocked), nivcsw
+ * the involuntary ones (it was preempted).
+ *
+ *   cc -O2 -o rusage_run bench/rusage_run.c
+ *   ./rusage_run ./philo 200 800 200 200 > /dev/null
+ */
+
+static double	seconds(struct timeval *tv)
+{
+	return (tv->tv_sec + tv->tv_usec / 1e6);
+}
+
+int	main(int argc, char **argv)
+{
+	struct timespec	start;
+	struct timespec	end;
+	struct rusage	usage;
+	pid_t			pid;
+	int				status;
+
+	if (argc < 2)
+	{
+		fprintf(stderr, "usage: %s command [args...]\n", argv[0]);
+		return (2);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	pid = fork();
+	if (pid == 0)
+	{
+		execvp(argv[1], argv + 1);
+		perror(argv[1]);
+		_exit(127);
+	}
+	if (pid < 0 || wait4(pid, &status, 0, &usage) < 0)
+		return (perror("rusage_run"), 2);
+	clock_gettime(CLOCK_MONOTONIC, &end);
+	fprintf(stderr, "wall=%.3f user=%.3f sys=%.3f nvcsw=%ld nivcsw=%ld "
+		"maxrss_kb=%ld\n", (end.tv_sec - start.tv_sec) + (end.tv_nsec
+			- start.tv_nsec) / 1e9, seconds(&usage.ru_utime),
+		seconds(&usage.ru_stime), usage.ru_nvcsw, usage.ru_nivcsw,
+		usage.ru_maxrss);
+	return (!(WIFEXITED(status) && WEXITSTATUS(status) == 0));
+}
@@ -0,0 +1,212 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_top.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:42:15 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:31:22 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <sys/stat.h>
+#include "../philo.h"
+
+/*
+ * stats_top watches a simulation run with --stats-shm, from the file it
+ * publishes in, without ever touching the process:
+ *
+ *   cc -O2 -o stats_top bench/stats_top.c
+ *   ./philo --stats-shm=/dev/shm/philo 200 800 200 200 > /dev/null &
+ *   ./stats_top /dev/shm/philo 500
+ *
+ * Every interval, 1000ms by default, it prints a line: the clock of the
+ * simulation, the meals so far and per second since the previous line,
+ * how many seats are full, what the seats are doing, and the hunger
+ * margin, how long until a seat starves, the smallest one and the mean,
+ * from the time_to_die of every seat, with --profile they differ.
+ * It stops once the simulation stopped, or the process is gone.
+ */
+
+typedef struct s_sample
+{
+	long			meals;
+	unsigned int	states[ALL_FULL];
+	long			min_margin;
+	unsigned int	min_seat;
+	double			sum_margin;
+	long			now;
+	struct timespec	at;
+}					t_sample;
+
+static const char	*g_stops[] = {"running", "died", "all full", "error",
+	"time up"};
+
+/*
+ * Waits for the file to be at least size bytes, then maps that much.
+ */
+static void	*map_stats(int fd, size_t size)
+{
+	struct stat	st;
+	int			tries;
+	void		*map;
+
+	tries = 0;
+	while (!fstat(fd, &st) && (size_t)st.st_size < size && tries++ < 500)
+		usleep(10000);
+	if ((size_t)st.st_size < size)
+		return (NULL);
+	map = mmap(NULL, size, PROT_READ, MAP_SHARED, fd, 0);
+	if (map == MAP_FAILED)
+		return (NULL);
+	return (map);
+}
+
+#define SEAT_TRIES 1048576
+
+/*
+ * The reader side of the sequence lock of the seat, it retries while the
+ * seat is written, the seat never waits for it. A process that died in
+ * the middle of a write leaves seq odd for good: every 1024 tries the
+ * process is looked for, and after SEAT_TRIES, or once it is gone, the
+ * values are taken as they are.
+ */
+static int	read_seat(t_shm_header *header, t_shm_seat *seat, long *last_meal)
+{
+	unsigned int	seq;
+	int				eaten;
+	int				tries;
+
+	tries = 0;
+	while (1)
+	{
+		seq = atomic_load_explicit(&seat->seq, memory_order_acquire);
+		*last_meal = atomic_load_explicit(&seat->last_meal,
+				memory_order_relaxed);
+		eaten = atomic_load_explicit(&seat->times_eaten,
+				memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+		if (seq % 2 == 0
+			&& atomic_load_explicit(&seat->seq, memory_order_relaxed) == seq)
+			return (eaten);
+		if (++tries >= SEAT_TRIES
+			|| (tries % 1024 == 0 && kill(header->pid, 0)))
+			return (eaten);
+	}
+}
+
+static void	take_sample(t_shm_header *header, t_sample *s, long now)
+{
+	t_shm_seat		*seats;
+	unsigned int	i;
+	long			last_meal;
+	long			margin;
+	int				state;
+
+	seats = (t_shm_seat *)(header + 1);
+	memset(s, 0, sizeof(t_sample));
+	s->now = now;
+	s->min_margin = LONG_MAX;
+	i = 0;
+	while (i < header->num_philos)
+	{
+		s->meals += read_seat(header, &seats[i], &last_meal);
+		margin = seats[i].time_to_die - (now - last_meal);
+		s->sum_margin += margin;
+		if (margin < s->min_margin)
+			s->min_seat = i + 1;
+		if (margin < s->min_margin)
+			s->min_margin = margin;
+		state = atomic_load_explicit(&seats[i++].state, memory_order_relaxed);
+		if (state >= 0 && state < ALL_FULL)
+			s->states[state]++;
+	}
+	clock_gettime(CLOCK_MONOTONIC, &s->at);
+}
+
+static void	print_sample(t_shm_header *header, t_sample *s, t_sample *prev)
+{
+	double	seconds;
+
+	seconds = (s->at.tv_sec - prev->at.tv_sec)
+		+ (s->at.tv_nsec - prev->at.tv_nsec) / 1e9;
+	printf("%9.3f s  meals %ld  %.1f/s  full %u/%u  take %u eat %u "
+		"sleep %u think %u  margin min %.1f ms (seat %u) mean %.1f ms",
+		s->now / 1e6, s->meals, (s->meals - prev->meals) / seconds,
+		atomic_load(&header->ate_max_meal), header->num_philos,
+		s->states[FIRST_CHOPSTICK] + s->states[SECOND_CHOPSTICK],
+		s->states[EATING], s->states[SLEEPING], s->states[THINKING],
+		s->min_margin / 1e3, s->min_seat,
+		s->sum_margin / header->num_philos / 1e3);
+	if (atomic_load(&header->stop) != RUNNING)
+		printf("  %s", g_stops[atomic_load(&header->stop) % 5]);
+	printf("\n");
+	fflush(stdout);
+}
+
+/*
+ * The header is mapped first, its version says when the rest is set,
+ * then the whole file, and the mapping of the header alone is dropped.
+ * Returns NULL if there is no stats file in argv.
+ */
+static t_shm_header	*open_stats(int argc, char **argv)
+{
+	int				fd;
+	t_shm_header	*header;
+	size_t			size;
+
+	fd = -1;
+	if (argc == 2 || argc == 3)
+		fd = open(argv[1], O_RDONLY);
+	header = NULL;
+	if (fd >= 0)
+		header = map_stats(fd, sizeof(t_shm_header));
+	while (header && !atomic_load(&header->version))
+		usleep(1000);
+	size = 0;
+	if (header && atomic_load(&header->version) == SHM_VERSION
+		&& !memcmp(header->magic, SHM_MAGIC, 8))
+		size = sizeof(t_shm_header) + sizeof(t_shm_seat) * header->num_philos;
+	if (header)
+		munmap(header, sizeof(t_shm_header));
+	header = NULL;
+	if (size)
+		header = map_stats(fd, size);
+	if (fd >= 0)
+		close(fd);
+	return (header);
+}
+
+/*
+ * A sample is taken right away, so the first line has a rate already.
+ * The stop is read before the last sample, which shows the outcome.
+ */
+int	main(int argc, char **argv)
+{
+	t_shm_header	*header;
+	t_sample		samples[2];
+	unsigned int	i;
+	int				interval;
+	int				running;
+
+	header = open_stats(argc, argv);
+	if (!header)
+		return (fprintf(stderr, "usage: %s stats_file [ms]\n", argv[0]), 1);
+	interval = 1000;
+	if (argc == 3)
+		interval = atoi(argv[2]);
+	i = 0;
+	take_sample(header, &samples[0], atomic_load(&header->now));
+	running = 1;
+	while (running)
+	{
+		usleep(1000 * interval);
+		running = (atomic_load(&header->stop) == RUNNING
+				&& !kill(header->pid, 0));
+		samples[++i % 2].now = atomic_load(&header->now);
+		take_sample(header, &samples[i % 2], samples[i % 2].now);
+		print_sample(header, &samples[i % 2], &samples[(i + 1) % 2]);
+	}
+	return (0);
+}
@@ -0,0 +1,67 @@
+#!/bin/sh
+# The sweep behind "make survival". For every strategy and table size it
+# looks for the smallest time_to_die at which nobody dies within MEALS
+# meals each, by bisection between the bound and the bound + SPAN, to
+# STEP milliseconds. The bound is the shortest period any schedule can
+# feed every seat in: max(k * time_to_eat, time_to_eat + time_to_sleep),
+# with k = 2 seats sharing a chopstick on an even table and 3 on an odd
+# one. One row per pair goes to the CSV:
+#   strategy,philos,time_to_eat,time_to_sleep,bound_ms,min_time_to_die_ms,
+#   ratio
+# ratio is min_time_to_die / (time_to_eat + time_to_sleep), empty if even
+# bound + SPAN was not survived. The binary is expected in BENCH_DIR.
+#
+# usage: make survival [SURVIVAL_CSV=file] [PHILOS="4 5 50 51"]
+#        [STRATEGIES="default hierarchy waiter chandy-misra ticket edf"]
+#        [TTE=100] [TTS=100] [MEALS=10] [SPAN=128] [STEP=2]
+
+OUT=${BENCH_DIR:-bench_build}
+CSV=${SURVIVAL_CSV:-survival_results.csv}
+PHILOS=${PHILOS:-4 5 50 51}
+STRATEGIES=${STRATEGIES:-default hierarchy waiter chandy-misra ticket edf}
+TTE=${TTE:-100}
+TTS=${TTS:-100}
+MEALS=${MEALS:-10}
+SPAN=${SPAN:-128}
+STEP=${STEP:-2}
+
+# survives strategy philos time_to_die
+survives()
+{
+	! "$OUT/philo" --strategy="$1" "$2" "$3" "$TTE" "$TTS" "$MEALS" \
+		| grep -q 'died'
+}
+
+echo "strategy,philos,time_to_eat,time_to_sleep,bound_ms,\
+min_time_to_die_ms,ratio" > "$CSV"
+for strategy in $STRATEGIES
+do
+	for n in $PHILOS
+	do
+		k=$((2 + n % 2))
+		bound=$((k * TTE))
+		[ $((TTE + TTS)) -gt $bound ] && bound=$((TTE + TTS))
+		lo=$bound
+		hi=$((bound + SPAN))
+		if survives "$strategy" "$n" "$hi"
+		then
+			while [ $((hi - lo)) -gt "$STEP" ]
+			do
+				mid=$(((lo + hi) / 2))
+				if survives "$strategy" "$n" "$mid"
+				then
+					hi=$mid
+				else
+					lo=$mid
+				fi
+			done
+			ratio=$(echo "$hi $TTE $TTS" | awk '{ printf "%.3f", $1 / ($2 + $3) }')
+		else
+			hi=
+			ratio=
+		fi
+		row="$strategy,$n,$TTE,$TTS,$bound,$hi,$ratio"
+		echo "$row" >> "$CSV"
+		echo "$row"
+	done
+done
@@ -0,0 +1,133 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sweep_bench.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:03:24 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:03:24 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../philo.h"
+
+/*
+ * sweep_bench times one full sweep of the dense deadlines of
+ * --monitor=sweep, for every way sweep_simd.c has to do it, at every
+ * table size given, and checks they all find the same earliest deadline.
+ *
+ *   cc -O2 -pthread -o sweep_bench bench/sweep_bench.c sweep_simd.c
+ *   ./sweep_bench 1000 10000 100000 1000000
+ *
+ * A sweep is repeated until it took about 200ms, the time printed is the
+ * mean of one full sweep, the deadlines stay in whatever cache they fit.
+ * Built with the thread sanitizer only the scalar sweep is there.
+ */
+
+static const char	*g_names[] = {"best", "avx2", "sse4.2", "scalar"};
+
+static time_t	now_ns(void)
+{
+	struct timespec	ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (ts.tv_sec * 1000000000L + ts.tv_nsec);
+}
+
+/*
+ * Deadlines a few seconds apart at most, like the ones of a table, the
+ * earliest one somewhere in the middle.
+ */
+static _Atomic time_t	*make_deadlines(size_t count)
+{
+	_Atomic time_t	*deadlines;
+	size_t			i;
+
+	if (posix_memalign((void **)&deadlines, CACHE_LINE,
+			sizeof(time_t) * count))
+		return (NULL);
+	srandom(42);
+	i = 0;
+	while (i < count)
+		atomic_init(&deadlines[i++], 1000000000L + random() % 5000000);
+	atomic_store(&deadlines[count / 2 + 3], 999999999L);
+	return (deadlines);
+}
+
+/*
+ * Prints the mean time of a sweep with the given way, and returns the
+ * earliest deadline it found, -1 if the CPU cannot do it.
+ */
+static time_t	time_sweep(_Atomic time_t *deadlines, size_t count,
+		t_simd simd)
+{
+	t_sweep	sweep;
+	time_t	earliest;
+	time_t	start;
+	time_t	elapsed;
+	long	runs;
+
+	sweep = pick_sweep(simd);
+	if (!sweep)
+		return (-1);
+	runs = 0;
+	start = now_ns();
+	elapsed = 0;
+	while (elapsed < 200000000L)
+	{
+		earliest = sweep(deadlines, count);
+		runs++;
+		elapsed = now_ns() - start;
+	}
+	printf("%8zu %-7s %12.1f ns %8.3f ns/seat %7.2f GB/s\n", count,
+		g_names[simd], (double)elapsed / runs,
+		(double)elapsed / runs / count,
+		(double)count * sizeof(time_t) * runs / elapsed);
+	return (earliest);
+}
+
+static int	bench_size(size_t count)
+{
+	_Atomic time_t	*deadlines;
+	time_t			found;
+	time_t			earliest;
+	int				simd;
+	int				ok;
+
+	deadlines = make_deadlines(count);
+	if (!deadlines)
+		return (0);
+	ok = 1;
+	simd = SIMD_AVX2;
+	while (simd <= SIMD_SCALAR)
+	{
+		found = time_sweep(deadlines, count, simd++);
+		if (found == -1)
+			printf("%8zu %-7s not supported\n", count, g_names[simd - 1]);
+		else if (found != 999999999L)
+			ok = 0;
+	}
+	earliest = pick_sweep(SIMD_BEST)(deadlines, count);
+	ok = (ok && earliest == 999999999L);
+	if (!ok)
+		printf("%8zu the sweeps found different deadlines\n", count);
+	free(deadlines);
+	return (ok);
+}
+
+int	main(int argc, char **argv)
+{
+	static const char	*sizes[] = {"1000", "10000", "100000", "1000000"};
+	int					i;
+	int					ok;
+
+	ok = 1;
+	i = 1;
+	while (i < argc)
+		ok &= bench_size(strtoul(argv[i++], NULL, 10));
+	i = 0;
+	while (argc < 2 && i < 4)
+		ok &= bench_size(strtoul(sizes[i++], NULL, 10));
+	return (!ok);
+}
@@ -0,0 +1,136 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   table_bench.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:17:36 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:08:47 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "../philo.h"
+#include <linux/perf_event.h>
+
+/*
+ * table_bench times make_table, one sweep over every seat's deadline (what
+ * a referee walking the table does) and destroy_mutex_and_free_table, and
+ * counts the last level cache misses of each phase with perf_event_open.
+ * Where the hardware counters are not available (a VM, a container) the
+ * misses are printed as n/a and the page faults are still counted.
+ *
+ *   cc -O2 -pthread -o table_bench bench/table_bench.c \
+ *       $(ls *.c | grep -v '^main.c$')
+ *   ./table_bench 10000 100000
+ */
+
+static volatile time_t	g_sink;
+
+static int	open_counter(unsigned int type, unsigned long config)
+{
+	struct perf_event_attr	attr;
+
+	memset(&attr, 0, sizeof(attr));
+	attr.type = type;
+	attr.size = sizeof(attr);
+	attr.config = config;
+	attr.exclude_kernel = 1;
+	return (syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+}
+
+static long	read_counter(int fd)
+{
+	long	value;
+
+	if (fd < 0 || read(fd, &value, sizeof(value)) != sizeof(value))
+		return (-1);
+	return (value);
+}
+
+/*
+ * Returns what the counter counted since before, and -1 if the counter
+ * could not be opened.
+ */
+static long	counted_since(int fd, long before)
+{
+	if (fd < 0)
+		return (-1);
+	return (read_counter(fd) - before);
+}
+
+static void	print_phase(const char *name, time_t us, long misses, long faults)
+{
+	printf("  %-9s %10.3f ms", name, us / 1000.0);
+	if (misses < 0)
+		printf("   llc-misses n/a");
+	else
+		printf("   llc-misses %9ld", misses);
+	printf("   page-faults %7ld\n", faults);
+}
+
+static void	init_info(t_shared *info, unsigned int n)
+{
+	memset(info, 0, sizeof(t_shared));
+	info->num_philos = n;
+	info->time_to_die = 800000;
+	info->num_meals = -1;
+	info->sim_start_time = get_time_us();
+	pthread_mutex_init(&info->monitor.mutex, NULL);
+	pthread_cond_init(&info->monitor.wakeup, NULL);
+	init_writer(info);
+}
+
+static void	bench_table(unsigned int n, int misses, int faults)
+{
+	t_shared		info;
+	time_t			start;
+	time_t			sum;
+	unsigned int	i;
+	long			before[2];
+
+	init_info(&info, n);
+	before[0] = read_counter(misses);
+	before[1] = read_counter(faults);
+	start = get_time_us();
+	info.table = make_table(&info);
+	print_phase("build", get_time_us() - start, counted_since(misses,
+			before[0]), counted_since(faults, before[1]));
+	before[0] = read_counter(misses);
+	before[1] = read_counter(faults);
+	start = get_time_us();
+	sum = 0;
+	i = 0;
+	while (i < n)
+		sum += info.monitor.heap[i++]->deadline;
+	g_sink = sum;
+	print_phase("sweep", get_time_us() - start, counted_since(misses,
+			before[0]), counted_since(faults, before[1]));
+	before[0] = read_counter(misses);
+	before[1] = read_counter(faults);
+	start = get_time_us();
+	destroy_mutex_and_free_table(&info);
+	print_phase("teardown", get_time_us() - start, counted_since(misses,
+			before[0]), counted_since(faults, before[1]));
+	free(info.writer->events);
+	free(info.writer->rings);
+	free(info.writer->pending);
+	free(info.writer);
+}
+
+int	main(int argc, char **argv)
+{
+	int	misses;
+	int	faults;
+	int	i;
+
+	misses = open_counter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES);
+	faults = open_counter(PERF_TYPE_SOFTWARE, PERF_COUNT_SW_PAGE_FAULTS);
+	i = 1;
+	while (i < argc)
+	{
+		printf("%s seats\n", argv[i]);
+		bench_table(ft_atoi(argv[i++]), misses, faults);
+	}
+	return (0);
+}
@@ -0,0 +1,47 @@
+#!/bin/sh
+# The sweep behind "make think". For every engine, table size and
+# time_to_die:time_to_eat:time_to_sleep it runs --think=fixed and
+# --think=adaptive until MEALS meals each (or a death), and appends one
+# row per run to the CSV:
+#   think,engine,philos,time_to_die,time_to_eat,time_to_sleep,meals_arg,
+#   meals,meals_per_s,interval_max_ms,min_slack_ms,end
+# min_slack is time_to_die minus the longest time any seat went between
+# two meals, how close the run came to a death, negative if one died.
+# The binaries are expected in BENCH_DIR.
+#
+# usage: make think [THINK_CSV=file] [PHILOS="5 50 200"]
+#        [TIMINGS="800:200:200"] [ENGINES="threads virtual"] [MEALS=20]
+
+OUT=${BENCH_DIR:-bench_build}
+CSV=${THINK_CSV:-think_results.csv}
+PHILOS=${PHILOS:-4 5 50 51 200}
+TIMINGS=${TIMINGS:-800:200:200 410:200:200 610:200:100 1000:100:100}
+ENGINES=${ENGINES:-threads virtual}
+MEALS=${MEALS:-20}
+
+echo "think,engine,philos,time_to_die,time_to_eat,time_to_sleep,\
+meals_arg,meals,meals_per_s,interval_max_ms,min_slack_ms,end" > "$CSV"
+for engine in $ENGINES
+do
+	mode=--engine=threads
+	[ "$engine" = virtual ] && mode=--virtual-time
+	for n in $PHILOS
+	do
+		for timing in $TIMINGS
+		do
+			set -- $(echo "$timing" | tr ':' ' ')
+			for think in fixed adaptive
+			do
+				"$OUT/philo" "$mode" --think="$think" "$n" "$1" "$2" "$3" \
+					"$MEALS" >"$OUT/out"
+				row="$think,$engine,$n,$1,$2,$3,$MEALS,$("$OUT/analyze" \
+					"$n" "$1" < "$OUT/out" | awk -F, -v ttd="$1" '{
+					printf "%s,%s,%s,", $1, $2, $5
+					if ($5 != "") printf "%d", ttd - $5
+					printf ",%s", $9 }')"
+				echo "$row" >> "$CSV"
+				echo "$row"
+			done
+		done
+	done
+done
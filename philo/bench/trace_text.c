@@ -0,0 +1,165 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_text.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:25:42 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:25:42 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include <sys/stat.h>
+#include "../philo.h"
+
+/*
+ * trace_text turns a --trace file back into the text philo prints, line
+ * for line the same format:
+ *
+ *   cc -O2 -o trace_text bench/trace_text.c
+ *   ./philo --trace=run.trace 5 800 200 200 7
+ *   ./trace_text run.trace > run.txt
+ *
+ * The regions of the file are merged in time order the way the writer
+ * orders what it drains: by time, the referee's last line after every
+ * event of the same microsecond, then region by region. Nothing after
+ * the last line is printed, like the writer drops it.
+ */
+
+typedef struct s_entry
+{
+	long		time;
+	uint32_t	code;
+	uint32_t	region;
+	size_t		seq;
+}				t_entry;
+
+static int	is_last(uint32_t code)
+{
+	return ((code & 7) == DIED || (code & 7) == ALL_FULL);
+}
+
+static int	compare_entries(const void *a, const void *b)
+{
+	const t_entry	*x;
+	const t_entry	*y;
+
+	x = (const t_entry *)a;
+	y = (const t_entry *)b;
+	if (x->time != y->time)
+		return ((x->time > y->time) - (x->time < y->time));
+	if (is_last(x->code) != is_last(y->code))
+		return (is_last(x->code) - is_last(y->code));
+	if (x->region != y->region)
+		return ((x->region > y->region) - (x->region < y->region));
+	return ((x->seq > y->seq) - (x->seq < y->seq));
+}
+
+static size_t	load(t_entry *entries, char *map, t_trace_header *header)
+{
+	t_record	*record;
+	size_t		n;
+	size_t		i;
+	uint32_t	region;
+	long		time;
+
+	record = (t_record *)(map + trace_offset(header->num_regions));
+	n = 0;
+	region = 0;
+	while (region < header->num_regions)
+	{
+		time = 0;
+		i = 0;
+		while (i < ((uint64_t *)(header + 1))[region])
+		{
+			time += record->delta;
+			entries[n] = (t_entry){time, record->code, region, i++};
+			n += ((record++)->code & 7) != TRACE_SKIP;
+		}
+		region++;
+	}
+	return (n);
+}
+
+static void	print_entries(t_entry *entries, size_t n, t_trace_header *header)
+{
+	static const char	*texts[] = {"has taken chopstick.",
+		"has taken a chopstick.", "is eating.", "is sleeping.",
+		"is thinking.", "died."};
+	size_t				i;
+
+	i = 0;
+	while (i < n)
+	{
+		if ((entries[i].code & 7) == ALL_FULL)
+			printf("All philos have eaten %d meals.\n", header->num_meals);
+		else
+			printf("%ld %u %s\n", entries[i].time / 1000,
+				entries[i].code >> 3, texts[entries[i].code & 7]);
+		if (is_last(entries[i++].code))
+			break ;
+	}
+	if (header->dropped)
+		fprintf(stderr, "%lu events did not fit, the trace is cut short\n",
+			(unsigned long)header->dropped);
+}
+
+/*
+ * The offset of the records is the one trace.c computes, it is repeated
+ * here so the tool builds from this file alone.
+ */
+size_t	trace_offset(unsigned int num_regions)
+{
+	size_t	size;
+
+	size = sizeof(t_trace_header) + sizeof(uint64_t) * num_regions;
+	return ((size + TRACE_PAGE - 1) / TRACE_PAGE * TRACE_PAGE);
+}
+
+static char	*map_file(const char *path, size_t *size)
+{
+	struct stat	st;
+	char		*map;
+	int			fd;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (NULL);
+	map = MAP_FAILED;
+	if (!fstat(fd, &st) && (size_t)st.st_size >= TRACE_PAGE)
+		map = mmap(NULL, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	*size = st.st_size;
+	if (map == MAP_FAILED || memcmp(map, TRACE_MAGIC, 8))
+		return (NULL);
+	return (map);
+}
+
+int	main(int argc, char **argv)
+{
+	char			*map;
+	size_t			size;
+	t_trace_header	*header;
+	t_entry			*entries;
+	size_t			total;
+
+	map = NULL;
+	if (argc == 2)
+		map = map_file(argv[1], &size);
+	if (!map)
+	{
+		fprintf(stderr, "usage: %s trace_file\n", argv[0]);
+		return (2);
+	}
+	header = (t_trace_header *)map;
+	total = (size - trace_offset(header->num_regions)) / sizeof(t_record);
+	entries = malloc(sizeof(t_entry) * (total + 1));
+	if (!entries)
+		return (1);
+	total = load(entries, map, header);
+	qsort(entries, total, sizeof(t_entry), compare_entries);
+	print_entries(entries, total, header);
+	free(entries);
+	return (0);
+}
@@ -0,0 +1,523 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   validate.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:39:00 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:13:57 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdbool.h>
+#include <stdarg.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <pthread.h>
+#include <time.h>
+
+/*
+ * validate reads the output of a philo run, as a stream, and checks what
+ * the simulation guarantees:
+ *   - time never goes backwards;
+ *   - a seat eats only after "has taken chopstick." then "has taken a
+ *     chopstick.", and sleeps only after eating;
+ *   - no seat eats while a neighbour eats, a meal is time_to_eat long;
+ *   - nothing comes after "died." or the all full line;
+ *   - "died." comes between time_to_die and time_to_die + 10ms after the
+ *     last meal of the seat, and no seat goes on past its death unseen;
+ *   - the all full line comes once every seat ate num_meals meals, and
+ *     it does come when they all did.
+ * Every violation is printed with its line number, the first 100 of
+ * them, and the exit status is 1 if there was any.
+ *
+ * The input is read in blocks, each block is cut at line ends into one
+ * chunk per thread, the chunks are parsed in parallel into fixed size
+ * records, then one pass over the records checks them in order, which
+ * costs much less than the parsing.
+ *
+ *   cc -O2 -pthread -o validate bench/validate.c
+ *   ./philo 200 800 200 200 10 | ./validate 200 800 200 200 10
+ *   ./validate -j 8 -f run.log 100000 800 200 200
+ *
+ * The times are the ones given to philo, in milliseconds. A log prints
+ * milliseconds truncated from microseconds, so meals of neighbours may
+ * seem to overlap by up to 1ms, that is tolerated.
+ */
+
+#define BLOCK_SIZE 67108864
+#define MAX_REPORTS 100
+#define DEATH_SLACK_MS 10
+
+enum e_kind
+{
+	FIRST,
+	SECOND,
+	EATING,
+	SLEEPING,
+	THINKING,
+	DIED,
+	ALL_FULL,
+	BAD
+};
+
+/*
+ * A parsed line, line counts from the start of its chunk. id is the
+ * number of meals of the all full line.
+ */
+typedef struct s_line
+{
+	long			time;
+	unsigned int	id;
+	unsigned int	kind;
+	unsigned long	line;
+}					t_line;
+
+typedef struct s_chunk
+{
+	pthread_t		thread;
+	const char		*start;
+	const char		*end;
+	t_line			*lines;
+	size_t			num_lines;
+	size_t			max_lines;
+	unsigned long	newlines;
+}					t_chunk;
+
+typedef struct s_seat
+{
+	long			last_meal;
+	long			eat_time;
+	long			eaten;
+	int				takes;
+	bool			eating;
+	bool			starved;
+}					t_seat;
+
+typedef struct s_check
+{
+	unsigned int	num_philos;
+	double			time_to_die;
+	long			time_to_eat;
+	long			num_meals;
+	t_seat			*seats;
+	unsigned long	base;
+	long			last_time;
+	unsigned long	ended;
+	unsigned long	violations;
+	unsigned long	lines;
+}					t_check;
+
+static const char	*g_texts[] = {"has taken chopstick.",
+	"has taken a chopstick.", "is eating.", "is sleeping.",
+	"is thinking.", "died."};
+static const long	g_lengths[] = {20, 22, 10, 12, 12, 5};
+
+static void	report(t_check *check, unsigned long line, const char *format,
+		...)
+{
+	va_list	args;
+
+	if (check->violations++ >= MAX_REPORTS)
+		return ;
+	printf("line %lu: ", line);
+	va_start(args, format);
+	vprintf(format, args);
+	va_end(args);
+	printf("\n");
+}
+
+/*
+ * Reads the digits at *p into value, returns false if there is none.
+ */
+static bool	get_number(const char **p, const char *end, long *value)
+{
+	const char	*start;
+
+	start = *p;
+	*value = 0;
+	while (*p < end && **p >= '0' && **p <= '9')
+		*value = *value * 10 + *(*p)++ - '0';
+	return (*p != start);
+}
+
+/*
+ * "<time> <id> <text>" or "All philos have eaten <n> meals.", anything
+ * else is BAD.
+ */
+static unsigned int	parse_line(const char *p, const char *end, t_line *out)
+{
+	long			value;
+	unsigned int	kind;
+
+	if (end - p > 22 && !memcmp(p, "All philos have eaten ", 22))
+	{
+		p += 22;
+		out->time = -1;
+		if (!get_number(&p, end, &value) || end - p != 7
+			|| memcmp(p, " meals.", 7))
+			return (BAD);
+		out->id = value;
+		return (ALL_FULL);
+	}
+	if (!get_number(&p, end, &out->time) || p == end || *p++ != ' '
+		|| !get_number(&p, end, &value) || p == end || *p++ != ' ')
+		return (BAD);
+	out->id = value;
+	kind = FIRST;
+	while (kind <= DIED && (end - p != g_lengths[kind]
+			|| memcmp(p, g_texts[kind], end - p)))
+		kind++;
+	if (kind > DIED)
+		return (BAD);
+	return (kind);
+}
+
+static void	*parse_chunk(void *arg)
+{
+	t_chunk		*chunk;
+	const char	*p;
+	const char	*nl;
+	t_line		*line;
+
+	chunk = (t_chunk *)arg;
+	p = chunk->start;
+	while (p < chunk->end)
+	{
+		nl = memchr(p, '\n', chunk->end - p);
+		if (chunk->num_lines == chunk->max_lines)
+		{
+			chunk->max_lines = chunk->max_lines * 2 + 65536;
+			chunk->lines = realloc(chunk->lines,
+					sizeof(t_line) * chunk->max_lines);
+			if (!chunk->lines)
+				exit(1);
+		}
+		line = &chunk->lines[chunk->num_lines++];
+		line->line = ++chunk->newlines;
+		line->kind = parse_line(p, nl, line);
+		p = nl + 1;
+	}
+	return (NULL);
+}
+
+/*
+ * A seat that has not eaten for time_to_die plus the slack should have
+ * been reported dead by now, reported once per hunger.
+ */
+static void	check_hunger(t_check *check, t_seat *seat, long time,
+		unsigned long line)
+{
+	if (seat->starved || time <= seat->last_meal + check->time_to_die
+		+ DEATH_SLACK_MS)
+		return ;
+	seat->starved = true;
+	report(check, line, "seat %ld has not eaten since %ld, it should have "
+		"died at %.0f", seat - check->seats + 1, seat->last_meal,
+		seat->last_meal + check->time_to_die);
+}
+
+static void	check_meal(t_check *check, t_seat *seat, t_line *l,
+		unsigned long line)
+{
+	t_seat	*neighbours[2];
+	int		i;
+
+	if (seat->takes != 2)
+		report(check, line, "seat %u eats without both chopsticks", l->id);
+	neighbours[0] = &check->seats[(l->id - 2 + check->num_philos)
+		% check->num_philos];
+	neighbours[1] = &check->seats[l->id % check->num_philos];
+	i = -1;
+	while (++i < 2)
+		if (neighbours[i] != seat && neighbours[i]->eating
+			&& l->time + 1 < neighbours[i]->eat_time + check->time_to_eat)
+			report(check, line, "seat %u eats while seat %ld eats since %ld",
+				l->id, neighbours[i] - check->seats + 1,
+				neighbours[i]->eat_time);
+	seat->eating = true;
+	seat->eat_time = l->time;
+	seat->last_meal = l->time;
+	seat->takes = 0;
+	seat->eaten++;
+	seat->starved = false;
+}
+
+static void	check_death(t_check *check, t_seat *seat, t_line *l,
+		unsigned long line)
+{
+	long	hunger;
+
+	hunger = l->time - seat->last_meal;
+	if (hunger + 1 < check->time_to_die)
+		report(check, line, "seat %u died %ld ms after eating, before "
+			"time_to_die", l->id, hunger);
+	else if (hunger > check->time_to_die + DEATH_SLACK_MS)
+		report(check, line, "seat %u died %.0f ms late", l->id,
+			hunger - check->time_to_die);
+}
+
+static void	check_full(t_check *check, t_line *l, unsigned long line)
+{
+	unsigned int	i;
+
+	if (check->num_meals < 0 || l->id != check->num_meals)
+		report(check, line, "all full line for %u meals, %ld were asked",
+			l->id, check->num_meals);
+	i = 0;
+	while (i < check->num_philos && check->seats[i].eaten >= l->id)
+		i++;
+	if (i < check->num_philos)
+		report(check, line, "all full but seat %u ate %ld meals", i + 1,
+			check->seats[i].eaten);
+}
+
+static void	check_seat(t_check *check, t_line *l, unsigned long line)
+{
+	t_seat	*seat;
+
+	if (l->id == 0 || l->id > check->num_philos)
+		return (report(check, line, "no seat %u", l->id));
+	seat = &check->seats[l->id - 1];
+	if (l->kind != DIED)
+		check_hunger(check, seat, l->time, line);
+	if (l->kind == FIRST && seat->takes != 0)
+		report(check, line, "seat %u takes a first chopstick again", l->id);
+	if (l->kind == SECOND && seat->takes != 1)
+		report(check, line, "seat %u takes a second chopstick first", l->id);
+	if (l->kind == FIRST || l->kind == SECOND)
+		seat->takes = l->kind + 1;
+	if (l->kind == EATING)
+		check_meal(check, seat, l, line);
+	if (l->kind == SLEEPING && !seat->eating)
+		report(check, line, "seat %u sleeps without eating", l->id);
+	if (l->kind == SLEEPING)
+		seat->eating = false;
+	if (l->kind == DIED)
+		check_death(check, seat, l, line);
+}
+
+static void	check_line(t_check *check, t_line *l)
+{
+	unsigned long	line;
+
+	line = check->base + l->line;
+	check->lines = line;
+	if (check->ended)
+		report(check, line, "after the last line, line %lu", check->ended);
+	if (l->kind == BAD)
+		return (report(check, line, "not a line philo prints"));
+	if (l->kind == ALL_FULL || l->kind == DIED)
+		check->ended = line;
+	if (l->kind == ALL_FULL)
+		return (check_full(check, l, line));
+	if (l->time < check->last_time)
+		report(check, line, "time goes back from %ld to %ld",
+			check->last_time, l->time);
+	check->last_time = l->time;
+	check_seat(check, l, line);
+}
+
+static void	split_block(t_chunk *chunks, int count, const char *block,
+		size_t len)
+{
+	int	i;
+
+	i = -1;
+	while (++i < count)
+	{
+		chunks[i].start = block;
+		if (i)
+			chunks[i].start = chunks[i - 1].end;
+		chunks[i].end = block + len * (i + 1) / count;
+		while (chunks[i].end > block && chunks[i].end < block + len
+			&& chunks[i].end[-1] != '\n')
+			chunks[i].end++;
+		if (chunks[i].end < chunks[i].start)
+			chunks[i].end = chunks[i].start;
+		chunks[i].num_lines = 0;
+		chunks[i].newlines = 0;
+	}
+}
+
+/*
+ * Cuts the block, whose last byte ends a line, into count chunks, parses
+ * them in parallel, then checks their lines in order. A chunk whose
+ * thread cannot be made is parsed by the calling thread.
+ */
+static void	run_block(t_check *check, t_chunk *chunks, int count,
+		const char *block, size_t len)
+{
+	bool	*started;
+	int		i;
+	size_t	j;
+
+	started = calloc(count, sizeof(bool));
+	if (!started)
+		exit(1);
+	split_block(chunks, count, block, len);
+	i = -1;
+	while (++i < count)
+		started[i] = !pthread_create(&chunks[i].thread, NULL, parse_chunk,
+				&chunks[i]);
+	i = -1;
+	while (++i < count)
+	{
+		if (started[i])
+			pthread_join(chunks[i].thread, NULL);
+		else
+			parse_chunk(&chunks[i]);
+		j = 0;
+		while (j < chunks[i].num_lines)
+			check_line(check, &chunks[i].lines[j++]);
+		check->base += chunks[i].newlines;
+	}
+	free(started);
+}
+
+/*
+ * Once the input ends: nobody may still be starving unseen, and when
+ * every seat ate num_meals meals the all full line must have come.
+ */
+static void	check_end(t_check *check)
+{
+	unsigned int	i;
+	unsigned int	full;
+
+	full = 0;
+	i = 0;
+	while (!check->ended && i < check->num_philos)
+	{
+		check_hunger(check, &check->seats[i], check->last_time,
+			check->lines);
+		full += (check->num_meals > 0
+				&& check->seats[i].eaten >= check->num_meals);
+		i++;
+	}
+	if (!check->ended && check->num_philos && full == check->num_philos)
+		report(check, check->lines, "every seat ate %ld meals, there is no "
+			"all full line", check->num_meals);
+}
+
+/*
+ * Reads the input in blocks of BLOCK_SIZE, the part of the last line
+ * that did not fit goes to the next block. A last line without its
+ * newline gets one. Returns the number of bytes read.
+ */
+static size_t	validate(t_check *check, int fd, int threads)
+{
+	char	*block;
+	t_chunk	*chunks;
+	size_t	len;
+	size_t	cut;
+	size_t	total;
+	ssize_t	ret;
+
+	block = malloc(BLOCK_SIZE + 1);
+	chunks = calloc(threads, sizeof(t_chunk));
+	if (!block || !chunks)
+		exit(1);
+	len = 0;
+	total = 0;
+	while (true)
+	{
+		ret = read(fd, block + len, BLOCK_SIZE - len);
+		if (ret > 0)
+			len += ret;
+		if (ret > 0 && len < BLOCK_SIZE)
+			continue ;
+		if (!len)
+			break ;
+		cut = len;
+		while (ret > 0 && cut && block[cut - 1] != '\n')
+			cut--;
+		if (!cut)
+			cut = len;
+		if (ret <= 0 && block[len - 1] != '\n')
+			block[len++] = '\n';
+		if (ret <= 0)
+			cut = len;
+		run_block(check, chunks, threads, block, cut);
+		total += cut;
+		memmove(block, block + cut, len - cut);
+		len -= cut;
+		if (ret <= 0)
+			break ;
+	}
+	while (threads-- > 0)
+		free(chunks[threads].lines);
+	free(chunks);
+	free(block);
+	return (total);
+}
+
+static int	usage(const char *name)
+{
+	fprintf(stderr, "usage: %s [-j threads] [-f log] num_philos "
+		"time_to_die time_to_eat time_to_sleep [num_meals]\n", name);
+	return (2);
+}
+
+/*
+ * On stderr, so stdout only has the violations.
+ */
+static void	print_summary(t_check *check, size_t bytes, struct timespec *t)
+{
+	double	seconds;
+
+	seconds = (t[1].tv_sec - t[0].tv_sec) + (t[1].tv_nsec - t[0].tv_nsec)
+		/ 1e9;
+	if (check->violations > MAX_REPORTS)
+		printf("... and %lu more\n", check->violations - MAX_REPORTS);
+	fflush(stdout);
+	fprintf(stderr, "%lu lines, %.1f MB in %.3f s, %.0f MB/s, "
+		"%lu violations\n", check->lines, bytes / 1e6, seconds,
+		bytes / 1e6 / seconds, check->violations);
+}
+
+int	main(int argc, char **argv)
+{
+	t_check			check;
+	int				threads;
+	int				fd;
+	int				opt;
+	size_t			bytes;
+	struct timespec	times[2];
+
+	threads = sysconf(_SC_NPROCESSORS_ONLN);
+	fd = STDIN_FILENO;
+	opt = getopt(argc, argv, "j:f:");
+	while (opt == 'j' || opt == 'f')
+	{
+		if (opt == 'j')
+			threads = atoi(optarg);
+		else
+			fd = open(optarg, O_RDONLY);
+		opt = getopt(argc, argv, "j:f:");
+	}
+	if (opt != -1 || argc - optind < 4 || argc - optind > 5 || fd < 0
+		|| atoi(argv[optind]) <= 0)
+		return (usage(argv[0]));
+	memset(&check, 0, sizeof(t_check));
+	check.num_philos = atoi(argv[optind]);
+	check.time_to_die = atof(argv[optind + 1]);
+	check.time_to_eat = atof(argv[optind + 2]);
+	check.num_meals = -1;
+	if (argc - optind == 5)
+		check.num_meals = atol(argv[optind + 4]);
+	check.seats = calloc(check.num_philos, sizeof(t_seat));
+	if (!check.seats)
+		return (1);
+	clock_gettime(CLOCK_MONOTONIC, &times[0]);
+	bytes = validate(&check, fd, threads + (threads < 1) * (1 - threads));
+	check_end(&check);
+	clock_gettime(CLOCK_MONOTONIC, &times[1]);
+	print_summary(&check, bytes, times);
+	free(check.seats);
+	return (check.violations != 0);
+}
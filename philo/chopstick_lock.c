@@ -0,0 +1,124 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   chopstick_lock.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:11:43 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:26:08 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * When the neighbour holding the chopstick should put it down: at the end
+ * of his meal if he is eating, 0 if he is not, then nobody can tell.
+ */
+static time_t	release_time(t_philo *holder)
+{
+	time_t	end;
+
+	end = atomic_load_explicit(&holder->last_meal_time, memory_order_relaxed)
+		+ holder->profile->time_to_eat;
+	if (end + CHOPSTICK_SPIN_US < get_time_us())
+		return (0);
+	return (end);
+}
+
+/*
+ * Waits for the ticket to be served. A meal takes time_to_eat, so the
+ * waiter knows when the neighbour will put the chopstick down: it sleeps
+ * on now_serving until CHOPSTICK_SPIN_US before that, then spins,
+ * yielding the CPU so the holder can run, until CHOPSTICK_SPIN_US after.
+ * A chopstick handed over in that window is taken without a trip through
+ * the kernel. Outside the window, or if the holder is late, it sleeps
+ * until it is woken, rechecking every second.
+ */
+static void	ticket_wait(t_chopstick *chopstick, int ticket, t_philo *holder)
+{
+	int		serving;
+	time_t	release;
+	time_t	now;
+
+	serving = atomic_load(&chopstick->now_serving);
+	while (serving != ticket)
+	{
+		release = release_time(holder);
+		now = get_time_us();
+		if (release && now + CHOPSTICK_SPIN_US < release)
+			futex_wait_until(&chopstick->now_serving, serving,
+				release - CHOPSTICK_SPIN_US);
+		else if (release)
+			sched_yield();
+		else
+			futex_wait_until(&chopstick->now_serving, serving,
+				now + 1000000);
+		serving = atomic_load(&chopstick->now_serving);
+	}
+}
+
+/*
+ * Locks the left or right chopstick of the seat, a drop in for
+ * pthread_mutex_lock on its mutex, and returns what it would.
+ * With --chopstick-lock=ticket the chopstick is a ticket lock: the
+ * neighbours are served in the order they asked and a seat that puts
+ * the chopstick down cannot take it right back while the other waits,
+ * see ticket_wait. The ticket lock cannot fail.
+ * With --record or --replay every grant is stamped, and with --replay
+ * the seat first waits for its recorded turn, see grant_log.c.
+ */
+int	lock_chopstick(t_philo *philo, t_lock which)
+{
+	t_chopstick	*chopstick;
+	int			ret;
+
+	chopstick = chopstick_of(philo, which);
+	if (philo->info->grants)
+		replay_turn(philo, chopstick, which);
+	ret = 0;
+	if (philo->info->opt.chopstick_lock == CHOPSTICK_MUTEX)
+		ret = STAT_LOCK(philo, which, &chopstick->mutex);
+	else
+		ticket_wait(chopstick, atomic_fetch_add(&chopstick->next_ticket, 1),
+			neighbour_of(philo, which));
+	if (!ret && philo->info->grants)
+		record_grant(philo, chopstick, which);
+	return (ret);
+}
+
+/*
+ * Unlocks the left or right chopstick of the seat, and returns what
+ * pthread_mutex_unlock would. Serving the next ticket hands the
+ * chopstick straight to the waiting neighbour, the futex is only woken
+ * if there is one.
+ */
+int	unlock_chopstick(t_philo *philo, t_lock which)
+{
+	t_chopstick	*chopstick;
+	int			serving;
+
+	chopstick = chopstick_of(philo, which);
+	if (philo->info->opt.chopstick_lock == CHOPSTICK_MUTEX)
+		return (STAT_UNLOCK(philo, which, &chopstick->mutex));
+	serving = atomic_fetch_add(&chopstick->now_serving, 1) + 1;
+	if (atomic_load(&chopstick->next_ticket) != serving)
+		futex_wake(&chopstick->now_serving, 1);
+	return (0);
+}
+
+/*
+ * Puts both chopsticks of the seat down, right then left.
+ * Returns 0 in cases of an error, else returns 1.
+ */
+int	unlock_chopsticks(t_philo *philo)
+{
+	if (unlock_chopstick(philo, LOCK_RIGHT)
+		|| unlock_chopstick(philo, LOCK_LEFT))
+	{
+		printf("\nError: Mutex unlock failed.\n");
+		return (0);
+	}
+	return (1);
+}
@@ -6,65 +6,55 @@
 /*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/04 13:00:33 by sudaniel          #+#    #+#             */
-/*   Updated: 2025/01/08 06:40:40 by sudaniel         ###   ########.fr       */
+/*   Updated: 2026/10/18 03:17:10 by sudaniel         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /*
+ * The default strategy, see acquire_chopsticks.
  * Each philo, takes both chopsticks and reports they have
- * taken a chopstick.
+ * taken a chopstick. If the simulation stops meanwhile, or if he is
+ * alone at the table with a single chopstick, whatever he holds is put
+ * back down before he returns.
  * If an error occures, 0 is returned, else 1 is returned.
  * There would be easier ways to handle error cases instead
  * of wraping every call of the pthread functions in an if statement.
  */
-static int	take_chopsticks(t_philo *philo)
+int	take_chopsticks(t_philo *philo)
 {
-	if (pthread_mutex_lock(&philo->l_chopstick_mutex))
+	if (lock_chopstick(philo, LOCK_LEFT))
 	{
 		printf("Error: Chopstick mutex lock failed.\n");
 		return (0);
 	}
-	if (must_simulation_stop(philo))
-		return (0);
-	report_philo_state(philo, "has taken chopstick.");
-	if (philo->info->num_philos == 1)
+	if (!report_philo_state(philo, FIRST_CHOPSTICK)
+		|| philo->info->num_philos == 1)
 	{
-		philo_sleeps(philo, philo->info->time_to_die);
+		if (philo->info->num_philos == 1)
+			philo_sleeps(philo, philo->profile->time_to_die);
+		unlock_chopstick(philo, LOCK_LEFT);
 		return (0);
 	}
-	if (pthread_mutex_lock(philo->r_chopstick_mutex))
+	if (lock_chopstick(philo, LOCK_RIGHT))
 	{
-		pthread_mutex_unlock(&philo->l_chopstick_mutex);
+		unlock_chopstick(philo, LOCK_LEFT);
 		printf("Error: Chopstick mutex lock failed.\n");
 		return (0);
 	}
-	if (must_simulation_stop(philo))
+	if (!report_philo_state(philo, SECOND_CHOPSTICK))
+	{
+		unlock_chopsticks(philo);
 		return (0);
-	report_philo_state(philo, "has taken a chopstick.");
+	}
 	return (1);
 }
 
 /*
  * The philospher sleeps for time_to_sleep, when he wakes up,
  * he checks if the simulation must stop, if it must stop
- * he returns 0, else he moves on to think.
- * time_to_think, is used to regulate how much time a philosopher
- * thinks. This is important for
- * synchronization, because if a philospher can spare some
- * time to think and not starve, then that allows the other, the time
- * to grab the chopsticks and eat. It is calculated by dividing
- * the result of subtracting the time that has elapsed since the last meal
- * of a philosopher (this is roughly the sum of time_to_eat + time_to_sleep)
- * from the time_to_die.
- * If this time is less than or equal 10, he thinks for 0ms, if this
- * time is greater than or equal to 200, he thinks for 100ms else
- * he thinks for the calculated time.
- * why is it divided by 2? A philosopher is blocked, if he cannot lock
- * a mutex, this is managed by the operating system, therefore, it
- * is not known how long he is blocked for, to account for this possibility
- * it is divided by 2.
+ * he returns 0, else he moves on to think for think_time.
  */
 static int	philo_sleeps_then_thinks(t_philo *philo)
 {
@@ -72,18 +62,13 @@ static int	philo_sleeps_then_thinks(t_philo *philo)
 
 	if (must_simulation_stop(philo))
 		return (0);
-	if (!report_philo_state(philo, "is sleeping."))
+	if (!report_philo_state(philo, SLEEPING))
 		return (0);
-	philo_sleeps(philo, philo->info->time_to_sleep);
+	philo_sleeps(philo, philo->profile->time_to_sleep);
 	if (must_simulation_stop(philo))
 		return (0);
-	time_to_think = (philo->info->time_to_die
-			- (get_time_ms() - philo->last_meal_time)) / 2;
-	if (time_to_think >= 200)
-		time_to_think = 100;
-	else if (time_to_think <= 10)
-		time_to_think = 0;
-	if (!report_philo_state(philo, "is thinking."))
+	time_to_think = think_time(philo);
+	if (!report_philo_state(philo, THINKING))
 		return (0);
 	philo_sleeps(philo, time_to_think);
 	if (must_simulation_stop(philo))
@@ -94,55 +79,52 @@ static int	philo_sleeps_then_thinks(t_philo *philo)
 /*
  * A philosopher needs both chopsticks to his left and right to eat.
  * He acquires them and eats, before he eats, his start of last meal time
- * is recorded, he reports he is eating and he eats for time to eat.
- * After eating he unlocks the mutexes. If number of meals was specified,
+ * is recorded in his own seat and his deadline is moved in the monitor
+ * heap, he reports he is eating and he eats for time to eat.
+ * After eating he unlocks the mutexes, also when the simulation stopped
+ * while he was eating. If number of meals was specified,
  * then he needs to update times_eaten and if he has eaten number
  * of meals every philopher must eat, In the check_num_meals function
- * he locks the ate_max_meal_mutex, records that he has eaten max_meal times,
- * and unlocks the mutex.
+ * he records that he has eaten max_meal times with an atomic add.
  */
 static int	philo_eats(t_philo	*philo)
 {
-	if (!take_chopsticks(philo))
-		return (0);
-	pthread_mutex_lock(&philo->info->args_mutex);
-	philo->last_meal_time = get_time_ms();
-	pthread_mutex_unlock(&philo->info->args_mutex);
-	if (must_simulation_stop(philo))
-		return (0);
-	if (!report_philo_state(philo, "is eating."))
-	{
-		pthread_mutex_unlock(philo->r_chopstick_mutex);
-		pthread_mutex_unlock(&philo->l_chopstick_mutex);
-		return (0);
-	}
-	if (!philo_sleeps(philo, philo->info->time_to_eat))
-	{
-		pthread_mutex_unlock(philo->r_chopstick_mutex);
-		pthread_mutex_unlock(&philo->l_chopstick_mutex);
-		return (0);
-	}
-	if (!unlock_mutexes(philo->r_chopstick_mutex, &philo->l_chopstick_mutex))
-		return (0);
-	if (!check_num_meals(philo))
-		return (0);
-	return (1);
+	time_t	meal_time;
+	bool	ate;
+
+	if (!acquire_chopsticks(philo))
+		return (0);
+	meal_time = get_time_us();
+	ate = update_deadline(philo, meal_time);
+	if (ate)
+		record_meal(philo, meal_time, atomic_load_explicit(
+				&philo->times_eaten, memory_order_relaxed));
+	ate = ate && report_philo_state(philo, EATING)
+		&& philo_sleeps(philo, philo->profile->time_to_eat);
+	if (!release_chopsticks(philo) || !ate)
+		return (0);
+	return (check_num_meals(philo));
 }
 
 /*
- * The simulation proper. Every even numbered philospher is delayed a bit.
+ * The simulation proper, it starts once the start gate opens, at the
+ * same instant for everybody. Every even numbered philospher is delayed
+ * a bit.
  * This is the primary form of synchronization to avoid deadlock, as it
  * gives a little form of control over competition for the chopsticks.
+ * The other strategies avoid deadlocks by themselves and start at once.
  * The philosphers go to eat, sleep and think. Upon completion of the
  * simulation they return to the main thread where they are joined.
  */
-static void	*simulation(void *arg)
+void	*philo_routine(void *arg)
 {
 	t_philo	*philo;
 
 	philo = (t_philo *)arg;
-	if (philo->philo_id % 2 == 0)
-		if (!philo_sleeps(philo, 5))
+	wait_start_gate(philo->info);
+	if (philo->philo_id % 2 == 0
+		&& philo->info->opt.strategy == STRATEGY_DEFAULT)
+		if (!philo_sleeps(philo, 5000))
 			return (NULL);
 	while (true)
 	{
@@ -153,28 +135,3 @@ static void	*simulation(void *arg)
 	}
 	return (NULL);
 }
-
-/*
- * For every seat(node) at the table, a thread (philosopher) is created
- * and assigned the simulation function as its starting routine, the seat
- * or node is passed as argument to the simulation function.
- * If thread creation fails, 0 is returned, else, 1 is returned.
- */
-int	create_philos(t_philo *table)
-{
-	t_philo	*seat;
-
-	seat = table;
-	while (true)
-	{
-		if (pthread_create(&seat->thread_id, NULL, simulation, (void *)seat))
-		{
-			printf("Error: pthread_create failed.\n");
-			return (0);
-		}
-		seat = seat->right;
-		if (seat == table)
-			break ;
-	}
-	return (1);
-}
@@ -0,0 +1,132 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   deadline_heap.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:56:16 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:47:30 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Swaps two seats in the monitor heap and keeps their heap_pos in sync.
+ */
+static void	swap_seats(t_philo **heap, unsigned int a, unsigned int b)
+{
+	t_philo	*tmp;
+
+	tmp = heap[a];
+	heap[a] = heap[b];
+	heap[b] = tmp;
+	heap[a]->heap_pos = a;
+	heap[b]->heap_pos = b;
+}
+
+/*
+ * A meal only ever pushes a deadline later, so a seat can only move
+ * down the heap. It is swapped with its earliest child until both
+ * children have a later deadline, this is O(log num_philos). --profile
+ * builds the heap with it, see load_profile.
+ */
+void	sift_down(t_philo **heap, unsigned int size, unsigned int pos)
+{
+	unsigned int	child;
+
+	while (2 * pos + 1 < size)
+	{
+		child = 2 * pos + 1;
+		if (child + 1 < size
+			&& heap[child + 1]->deadline < heap[child]->deadline)
+			child++;
+		if (heap[pos]->deadline <= heap[child]->deadline)
+			break ;
+		swap_seats(heap, pos, child);
+		pos = child;
+	}
+}
+
+/*
+ * Records the new deadline of the philosopher, he would starve at
+ * meal_time + the time_to_die of his profile if he does not eat again.
+ * The referee does not need to be woken up, he sleeps until the old
+ * earliest deadline and that one could only have moved later. With
+ * --monitor=sweep the deadline goes into the dense array, no lock is
+ * taken. The seat's own deadline is still kept, nobody else reads it then
+ * and the stats take the previous meal from it.
+ */
+int	update_deadline(t_philo *philo, time_t meal_time)
+{
+	t_monitor	*monitor;
+
+	monitor = &philo->info->monitor;
+	STAT_MEAL(philo, meal_time);
+	if (monitor->deadlines)
+	{
+		philo->deadline = meal_time + philo->profile->time_to_die;
+		atomic_store_explicit(&monitor->deadlines[philo->philo_id - 1],
+			philo->deadline, memory_order_relaxed);
+		return (1);
+	}
+	if (STAT_LOCK(philo, LOCK_MONITOR, &monitor->mutex))
+	{
+		printf("\nError: Mutex lock failed.\n");
+		return (0);
+	}
+	philo->deadline = meal_time + philo->profile->time_to_die;
+	sift_down(monitor->heap, philo->info->num_philos, philo->heap_pos);
+	if (STAT_UNLOCK(philo, LOCK_MONITOR, &monitor->mutex))
+	{
+		printf("\nError: Mutex unlock failed.\n");
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * The last philosopher to reach num_meals sets all_full and wakes up the
+ * referee, who would otherwise sleep until the next deadline.
+ */
+int	kick_referee(t_shared *info)
+{
+	if (pthread_mutex_lock(&info->monitor.mutex))
+	{
+		printf("\nError: Mutex lock failed.\n");
+		return (0);
+	}
+	info->monitor.all_full = true;
+	pthread_cond_signal(&info->monitor.wakeup);
+	if (pthread_mutex_unlock(&info->monitor.mutex))
+	{
+		printf("\nError: Mutex unlock failed.\n");
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * The wakeup condition variable was made on CLOCK_MONOTONIC, the clock of
+ * get_time_us, so the deadline of the root seat is used as is, the
+ * referee is late by the wake up only, see main_thread.c for the bound.
+ * ETIMEDOUT is the normal way out of the wait.
+ */
+int	wait_next_deadline(t_shared *info)
+{
+	struct timespec	until;
+	time_t			deadline;
+	int				ret;
+
+	deadline = info->monitor.heap[0]->deadline;
+	us_to_timespec(deadline, &until);
+	ret = pthread_cond_timedwait(&info->monitor.wakeup,
+			&info->monitor.mutex, &until);
+	if (ret && ret != ETIMEDOUT)
+	{
+		printf("\nError: pthread_cond_timedwait failed.\n");
+		return (0);
+	}
+	return (1);
+}
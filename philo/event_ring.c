@@ -0,0 +1,140 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   event_ring.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:00:03 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:41:22 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Waits for a free slot in the ring. The writer drains every ring about
+ * every millisecond, so a full ring only happens when the output is
+ * slower than the philosophers, then the producer waits for it.
+ */
+static void	wait_for_room(t_ring *ring, unsigned int head)
+{
+	while (head - atomic_load_explicit(&ring->tail,
+			memory_order_acquire) >= ring->size)
+		usleep(100);
+}
+
+/*
+ * in_flight is raised before the stop check and the clock read, and
+ * lowered once the event is published. This is what lets the writer know
+ * that nothing older than its watermark is still on the way, and what
+ * keeps a philosopher from reporting after the referee stopped the
+ * simulation. The referee's own DIED or ALL_FULL event is pushed after
+ * the stop, so those skip the check. Room is waited for before in_flight
+ * is raised, the writer does not drain a ring while it is raised.
+ * The tables of --batch have no writer and no ring, the event is only
+ * checked against the stop. With --trace it goes to the trace file.
+ */
+int	push_event(t_ring *ring, t_shared *info, unsigned int id, t_state state)
+{
+	unsigned int	head;
+	t_event			*event;
+
+	if (!ring)
+		return (state == DIED || state == ALL_FULL || atomic_load_explicit(
+				&info->stop_epoch, memory_order_acquire) == RUNNING);
+	if (ring->records)
+		return (trace_event(ring, info, id, state));
+	head = atomic_load_explicit(&ring->head, memory_order_relaxed);
+	wait_for_room(ring, head);
+	atomic_store(&ring->in_flight, true);
+	if (state != DIED && state != ALL_FULL && atomic_load_explicit(
+			&info->stop_epoch, memory_order_acquire) != RUNNING)
+	{
+		atomic_store_explicit(&ring->in_flight, false, memory_order_release);
+		return (0);
+	}
+	event = &ring->events[head % ring->size];
+	event->time = sim_now(info) - info->sim_start_time;
+	event->philo_id = id;
+	event->state = state;
+	atomic_store_explicit(&ring->head, head + 1, memory_order_release);
+	atomic_store_explicit(&ring->in_flight, false, memory_order_release);
+	return (1);
+}
+
+/*
+ * Reports what the philospher is doing at a specific time. Nothing is
+ * printed here, the event goes into the philosopher's own ring and the
+ * writer thread prints it, so a slow terminal or pipe never holds a
+ * philosopher back. With --stats-shm the state is published there as
+ * well. Once the simulation has stopped nothing is reported anymore, it
+ * returns 0 in that case, else 1.
+ */
+int	report_philo_state(t_philo *philo, t_state state)
+{
+	if (!push_event(philo->ring, philo->info, philo->philo_id, state))
+		return (0);
+	publish_state(philo->info, philo->philo_id, state);
+	return (1);
+}
+
+
+/*
+ * Makes room for count more pending events, the pending array grows
+ * by doubling. Returns 0 if malloc fails, else 1.
+ */
+static int	reserve_pending(t_writer *writer, size_t count)
+{
+	t_pending	*bigger;
+	size_t		size;
+
+	if (writer->num_pending + count <= writer->max_pending)
+		return (1);
+	size = writer->max_pending * 2;
+	while (size < writer->num_pending + count)
+		size *= 2;
+	bigger = malloc(sizeof(t_pending) * size);
+	if (!bigger)
+	{
+		printf("Error: Malloc failed.\n");
+		return (0);
+	}
+	memcpy(bigger, writer->pending, sizeof(t_pending) * writer->num_pending);
+	free(writer->pending);
+	writer->pending = bigger;
+	writer->max_pending = size;
+	return (1);
+}
+
+/*
+ * Moves every event of every ring to the pending array. A producer with
+ * in_flight raised could be holding a time older than the watermark, so
+ * the writer waits for him to finish his push before draining his ring.
+ */
+void	collect_events(t_writer *writer)
+{
+	unsigned int	i;
+	unsigned int	tail;
+	unsigned int	head;
+	t_ring			*ring;
+
+	i = 0;
+	while (i < writer->num_rings)
+	{
+		ring = &writer->rings[i++];
+		while (atomic_load(&ring->in_flight))
+			sched_yield();
+		tail = atomic_load_explicit(&ring->tail, memory_order_relaxed);
+		head = atomic_load_explicit(&ring->head, memory_order_acquire);
+		if (head == tail || !reserve_pending(writer, head - tail))
+			continue ;
+		while (tail != head)
+		{
+			writer->pending[writer->num_pending].event
+				= ring->events[tail++ % ring->size];
+			writer->pending[writer->num_pending++].order = writer->order++;
+		}
+		atomic_store_explicit(&ring->tail, tail, memory_order_release);
+	}
+}
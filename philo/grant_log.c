@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grant_log.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:26:08 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:26:08 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Which one of the seats' logs holds the count of the chopstick, the
+ * chopstick i is the left one of the seat i.
+ */
+static t_grant_log	*log_of(t_shared *info, t_chopstick *chopstick)
+{
+	return (&info->grants[chopstick - info->chopsticks]);
+}
+
+/*
+ * Makes room for one more stamp, the stamps double. If malloc fails the
+ * simulation stops, a record with a hole in it could not be replayed.
+ * Returns 0 then, else 1.
+ */
+static int	reserve_stamp(t_philo *philo, t_grant_log *log)
+{
+	uint32_t	*bigger;
+	size_t		size;
+
+	if (log->count < log->size)
+		return (1);
+	size = log->size * 2 + 1024;
+	bigger = realloc(log->stamps, sizeof(uint32_t) * size);
+	if (!bigger)
+	{
+		printf("Error: Malloc failed.\n");
+		stop_simulation(philo->info, SIM_ERROR);
+		return (0);
+	}
+	log->stamps = bigger;
+	log->size = size;
+	return (1);
+}
+
+/*
+ * --replay: the seat waits until the chopstick was granted as many times
+ * as when it got it in the recorded run, the neighbour whose turn comes
+ * before is let through first. Once the seat ran out of stamps, or the
+ * chopstick went past its turn because the run took another way, the
+ * seat takes it like without --replay, as when the stamp is for the
+ * other chopstick. A stop wakes it up within 10ms.
+ */
+void	replay_turn(t_philo *philo, t_chopstick *chopstick, t_lock which)
+{
+	t_grant_log	*log;
+	t_grant_log	*counter;
+	int			turn;
+	int			granted;
+
+	log = &philo->info->grants[philo->philo_id - 1];
+	if (!philo->info->opt.replay || log->next >= log->count
+		|| (log->stamps[log->next] & 1) != (which == LOCK_RIGHT))
+		return ;
+	counter = log_of(philo->info, chopstick);
+	turn = log->stamps[log->next] >> 1;
+	granted = atomic_load_explicit(&counter->granted, memory_order_acquire);
+	while (granted < turn && atomic_load_explicit(&philo->info->stop_epoch,
+			memory_order_relaxed) == RUNNING)
+	{
+		futex_wait_until(&counter->granted, granted, get_time_us() + 10000);
+		granted = atomic_load_explicit(&counter->granted,
+				memory_order_acquire);
+	}
+}
+
+/*
+ * Called by the seat that holds the chopstick, nobody else writes its
+ * count meanwhile, so the stamp is a plain load and store, on a line
+ * only the two neighbours share. --record appends it to the seat's own
+ * log, --replay counts whether it matches the recorded one, moves on to
+ * the next stamp and wakes the neighbour that may be waiting for its
+ * turn.
+ */
+void	record_grant(t_philo *philo, t_chopstick *chopstick, t_lock which)
+{
+	t_grant_log	*log;
+	t_grant_log	*counter;
+	int			granted;
+	uint32_t	stamp;
+
+	log = &philo->info->grants[philo->philo_id - 1];
+	counter = log_of(philo->info, chopstick);
+	granted = atomic_load_explicit(&counter->granted, memory_order_relaxed);
+	atomic_store_explicit(&counter->granted, granted + 1,
+		memory_order_release);
+	stamp = (uint32_t)granted << 1 | (which == LOCK_RIGHT);
+	if (philo->info->opt.replay)
+	{
+		if (log->next < log->count && log->stamps[log->next] == stamp)
+			log->replayed++;
+		log->next++;
+		futex_wake(&counter->granted, INT_MAX);
+		return ;
+	}
+	if (reserve_stamp(philo, log))
+		log->stamps[log->count++] = stamp;
+}
@@ -0,0 +1,156 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   grant_log_file.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:26:08 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:26:08 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Writes the file of --record: GRANT_MAGIC and the number of seats, then
+ * for every seat the number of its stamps, 8 bytes, and the stamps, 4
+ * bytes each, in the byte order of the machine.
+ */
+static void	save_log(t_shared *info)
+{
+	FILE			*file;
+	unsigned int	i;
+	uint64_t		count;
+	int				ok;
+
+	file = fopen(info->opt.record, "wb");
+	ok = (file && fwrite(GRANT_MAGIC, 8, 1, file) == 1
+			&& fwrite(&info->num_philos, sizeof(uint32_t), 1, file) == 1);
+	i = 0;
+	while (ok && i < info->num_philos)
+	{
+		count = info->grants[i].count;
+		ok = (fwrite(&count, sizeof(count), 1, file) == 1
+				&& fwrite(info->grants[i].stamps, sizeof(uint32_t), count,
+					file) == count);
+		i++;
+	}
+	if (file && fclose(file))
+		ok = 0;
+	if (!ok)
+		printf("Error: Cannot write the record %s.\n", info->opt.record);
+}
+
+/*
+ * Reads the file of --record back, it must be of a table of as many
+ * seats, and no seat has more than 2^40 stamps. Returns 0 if it is not,
+ * or malloc fails, else 1.
+ */
+static int	load_log(t_shared *info, FILE *file)
+{
+	char			magic[8];
+	uint32_t		num_philos;
+	unsigned int	i;
+	uint64_t		count;
+	int				ok;
+
+	ok = (fread(magic, 8, 1, file) == 1 && !memcmp(magic, GRANT_MAGIC, 8)
+			&& fread(&num_philos, sizeof(num_philos), 1, file) == 1
+			&& num_philos == info->num_philos);
+	i = 0;
+	while (ok && i < info->num_philos)
+	{
+		ok = (fread(&count, sizeof(count), 1, file) == 1
+				&& count < (1UL << 40));
+		if (ok && count)
+		{
+			info->grants[i].stamps = malloc(sizeof(uint32_t) * count);
+			ok = (info->grants[i].stamps && fread(info->grants[i].stamps,
+						sizeof(uint32_t), count, file) == count);
+		}
+		info->grants[i++].count = count;
+	}
+	return (ok);
+}
+
+/*
+ * The stamps are taken in lock_chopstick, so only the strategies that
+ * lock their chopsticks in philosopher threads have any: the default one,
+ * the hierarchy and the ticket strategy.
+ */
+static bool	stamps_chopsticks(t_options *opt)
+{
+	return (opt->engine == ENGINE_THREADS && !opt->virtual_time
+		&& (opt->strategy == STRATEGY_DEFAULT
+			|| opt->strategy == STRATEGY_HIERARCHY
+			|| opt->strategy == STRATEGY_TICKET)
+		&& !(opt->record && opt->replay));
+}
+
+/*
+ * --record=FILE and --replay=FILE, a log for every seat, zeroed, see
+ * grant_log.c. The file of --replay is read now, the one of --record is
+ * written by close_grant_log. Returns 0 if the options do not go
+ * together, the file cannot be read or malloc fails, else 1.
+ */
+int	open_grant_log(t_shared *info)
+{
+	FILE			*file;
+	unsigned int	i;
+	int				ok;
+
+	if (!info->opt.record && !info->opt.replay)
+		return (1);
+	if (!stamps_chopsticks(&info->opt) || posix_memalign((void **)
+			&info->grants, CACHE_LINE, sizeof(t_grant_log) * info->num_philos))
+	{
+		printf("Error: Cannot --record or --replay this run.\n");
+		return (0);
+	}
+	memset(info->grants, 0, sizeof(t_grant_log) * info->num_philos);
+	i = 0;
+	while (i < info->num_philos)
+		atomic_init(&info->grants[i++].granted, 0);
+	if (!info->opt.replay)
+		return (1);
+	file = fopen(info->opt.replay, "rb");
+	ok = (file && load_log(info, file));
+	if (file)
+		fclose(file);
+	if (!ok)
+		printf("Error: Cannot replay %s.\n", info->opt.replay);
+	return (ok);
+}
+
+/*
+ * Writes the file of --record, the threads were joined, and frees every
+ * log. After --replay it tells on stderr how many of the recorded grants
+ * went to the same seat at the same turn, all of them unless the run
+ * took another way, or stopped before the last ones.
+ */
+void	close_grant_log(t_shared *info)
+{
+	unsigned int	i;
+	size_t			replayed;
+	size_t			count;
+
+	if (!info->grants)
+		return ;
+	if (info->opt.record)
+		save_log(info);
+	replayed = 0;
+	count = 0;
+	i = 0;
+	while (i < info->num_philos)
+	{
+		replayed += info->grants[i].replayed;
+		count += info->grants[i].count;
+		free(info->grants[i++].stamps);
+	}
+	if (info->opt.replay)
+		fprintf(stderr, "replayed %zu of %zu grants in order\n", replayed,
+			count);
+	free(info->grants);
+	info->grants = NULL;
+}
@@ -6,132 +6,93 @@
 /*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/12/23 08:44:34 by sudaniel          #+#    #+#             */
-/*   Updated: 2025/01/07 07:06:04 by sudaniel         ###   ########.fr       */
+/*   Updated: 2026/10/18 04:29:55 by sudaniel         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /*
- * get_time_ms:	Uses the gettimeofday function which sets the time_tv.sec and
- * 				usec members. It returns the number of milliseconds that has
- * 				elapsed since January 1st, 1970. if gettimeofday returns -1
- * 				which denotes an error to gettimeofday, 0 is returned.
- * 				gettimeofday returns 0 upon success.
+ * Starts the philosophers, a thread for each or the workers of the pool
+ * that run all of them. In virtual time the seats are only placed, the
+ * referee runs them himself. They all wait at the start gate, startup
+ * measures how long it takes until it opens. Returns 0 if it fails,
+ * else 1.
  */
-time_t	get_time_ms(void)
+static int	start_philos(t_shared *info)
 {
-	time_t			current_time_in_milliseconds;
-	struct timeval	time;
-
-	if (gettimeofday(&time, NULL))
-	{
-		printf("Error: gettimeofday failed.\n");
-		return (0);
-	}
-	current_time_in_milliseconds = time.tv_sec * 1000 + time.tv_usec / 1000;
-	return (current_time_in_milliseconds);
-}
-
-/*
- * Initializes the shared info struct with the valid input.
- * If the number of philosophers or number of meals is zero or
- * if any of the mutex initializations fails, false is returned, 
- * else true is returned signifying that the initialization was done
- * successfully.
- */
-static bool	init_args(t_shared *info, char **argv)
-{
-	info->num_philos = ft_atoi(argv[0]);
-	if (info->num_philos == 0)
-		return (false);
-	info->time_to_die = ft_atol(argv[1]);
-	info->time_to_eat = ft_atol(argv[2]);
-	info->time_to_sleep = ft_atol(argv[3]);
-	if (argv[4])
-	{
-		info->num_meals = ft_atoi(argv[4]);
-		if (!info->num_meals)
-			return (false);
-	}
-	else
-		info->num_meals = -1;
-	info->ate_max_meal = 0;
-	info->sim_start_time = get_time_ms();
-	if (!info->sim_start_time)
-		return (false);
-	if (pthread_mutex_init(&info->args_mutex, NULL))
-		return (false);
-	info->is_philo_dead = false;
-	info->have_all_philos_eaten_max_meal = false;
-	info->table = NULL;
-	return (true);
+	info->startup = get_time_us();
+	if (info->opt.virtual_time)
+		return (setup_pool(info));
+	if (info->opt.engine == ENGINE_POOL)
+		return (start_pool(info));
+	return (create_philos(info->table));
 }
 
 /*
- * Checks if the inputs are non numerical, since any value entered
- * must be a positive value, the char '-' is considered as an error,
- * and false is returned.
- * If everything is fine after calling the init_args function, true
- * is returned.
+ * The plan of --strategy=schedule must feed everybody, else nothing is
+ * made. Makes the writer thread that prints the states of the philosophers,
+ * or the trace file they store them in with --trace, and the file of
+ * --stats-shm, they are set up before anybody can report, the latter is
+ * filled once the table and its profile are made. Creates an
+ * array of seats to mimic a round table, the last seat being next to the
+ * first, if making the table fails, an error code is returned.
+ * The Philosophers(threads) are created and if an error occurs at any point
+ * The already made table and the mutexes in them are destroyed and freed,
+ * and an error code is returned.
+ * Once the philosophers are created and the start gate opened, the
+ * simulation starts, the main thread
+ * proceeds to refereeing the simulation, he would flag the end of 
+ * simulation when a philosopher starves or they have all had at least the
+ * number of meals required.
+ * When the simulation ends, the meals of every class of --profile are
+ * printed, all mutexes are destroyed and the table freed.
  */
-static bool	check_args_and_init(char **argv, t_shared *info)
+static int	simulate(t_shared *info)
 {
-	int		i;
-	char	*args;
-
-	i = 0;
-	while (argv[i])
+	if (!check_schedule(info) || !init_writer(info) || !open_trace(info)
+		|| !open_stats_shm(info))
+		return (1);
+	info->table = make_table(info);
+	if (!info->table || !STATS_INIT(info) || !setup_pinning(info)
+		|| !open_grant_log(info) || !start_writer(info))
+		return (1);
+	ready_stats_shm(info);
+	if (!start_philos(info))
 	{
-		args = argv[i];
-		while (*args)
-		{
-			if (*args == '+')
-				args++;
-			if ('0' > *args || *args > '9')
-				return (false);
-			args++;
-		}
-		i++;
+		stop_simulation(info, SIM_ERROR);
+		open_start_gate(info);
+		finish_writer(info);
+		destroy_mutex_and_free_table(info);
+		return (1);
 	}
-	if (!init_args(info, argv))
-		return (false);
-	return (true);
+	open_start_gate(info);
+	referee(info);
+	STATS_DUMP(info);
+	print_profile(info);
+	destroy_mutex_and_free_table(info);
+	return (0);
 }
 
 /*
- * Declares the shared info struct data type, validates the user input,
+ * Declares the shared info struct data type, reads the options that come
+ * before the numbers, validates the user input,
  * returns an error code if the argument count does not match the required
- * or the inputs are invalid. Creates a circlular linked list to mimic
- * a round table, if making the table fails, an error code is returned.
- * The Philosophers(threads) are created and if an error occurs at any point
- * The already made table and the mutexes in them are destroyed and freed,
- * and an error code is returned.
- * Upon creating the philosophers, the simulation starts, the main thread
- * proceeds to refereeing the simulation, he would flag the end of 
- * simulation when a philosopher starves or they have all had at least the
- * number of meals required.
- * When the simulation ends, all mutexes are destroyed and the
- * list (table) freed.
+ * or the inputs are invalid. With --batch there are no numbers, the
+ * tables come from the file, see batch.c.
  */
 int	main(int argc, char **argv)
 {
 	t_shared	info;
 
+	if (!parse_options(&argc, &argv, &info.opt))
+		argc = 0;
+	else if (info.opt.batch)
+		return (run_batch(&info.opt));
 	if (argc < 5 || argc > 6 || !check_args_and_init(argv + 1, &info))
 	{
 		printf("Error: Invalid Input or mutex initialization failed.\n");
 		return (1);
 	}
-	info.table = make_table(&info);
-	if (!info.table)
-		return (1);
-	if (!create_philos(info.table))
-	{
-		destroy_mutex_and_free_table(&info);
-		return (1);
-	}
-	referee(&info);
-	destroy_mutex_and_free_table(&info);
-	return (0);
+	return (simulate(&info));
 }
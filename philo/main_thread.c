@@ -6,99 +6,113 @@
 /*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/06 06:34:01 by sudaniel          #+#    #+#             */
-/*   Updated: 2025/01/08 06:39:19 by sudaniel         ###   ########.fr       */
+/*   Updated: 2026/10/18 04:47:30 by sudaniel         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /*
- * Locks the args_mutex, but checks if the pthread function 
- * returned an error code. If so an error message is 
- * printed the is_philo_dead bool flag is set to true,
- * and true is returned. else false is returned. 
- * This is simply to end the simulation. Perhaps an error bool
- * variable could be used instead of flagging the is_philo_dead true.
+ * The stop_epoch is set before the last event is pushed in the referee's
+ * ring, push_event checks it, so no philosopher can report after "died."
+ * or after the all full line, and the writer prints the referee's event
+ * last. philo is the starving philosopher when reason is PHILO_DIED.
+ * When the virtual clock runs out there is no last line to print.
+ * This is stop_simulation with the sleepers woken only once the last
+ * event is stamped: woken first, on a machine with fewer CPUs than
+ * philosophers they ran before the referee, and a table of 200 printed
+ * its "died." line 3ms late, 10ms and more with -fsanitize=thread.
  */
-static bool	check_mutex_lock_error(t_shared *info)
+void	report_end(t_shared *info, t_philo *philo, t_stop reason)
 {
-	if (pthread_mutex_lock(&info->args_mutex))
-	{
-		printf("\nError: Mutex lock failed.\n");
-		info->is_philo_dead = true;
-		return (true);
-	}
-	return (false);
-}
+	t_ring	*ring;
+	int		expected;
 
-/*
- * Similar to the check_mutex_lock_error function,
- * it simply unlocks the locked mutex.
- */
-static bool	check_mutex_unlock_error(t_shared *info)
-{
-	if (pthread_mutex_unlock(&info->args_mutex))
+	expected = RUNNING;
+	if (!atomic_compare_exchange_strong(&info->stop_epoch, &expected,
+			reason))
+		return ;
+	publish_stop(info, reason);
+	ring = NULL;
+	if (info->writer)
+		ring = &info->writer->rings[info->writer->num_rings - 1];
+	if (ring && reason == PHILO_DIED)
 	{
-		printf("\nError: Mutex unlock failed.\n");
-		info->is_philo_dead = true;
-		return (true);
+		push_event(ring, info, philo->philo_id, DIED);
+		publish_state(info, philo->philo_id, DIED);
 	}
-	return (false);
+	else if (ring && reason == ALL_PHILOS_FULL)
+		push_event(ring, info, 0, ALL_FULL);
+	wake_sleepers(info);
 }
 
 /*
  * Checks if any philosopher is dead or if they have all eaten the
- * required amount of meal, to do this he needs to lock the args
- * mutex which is done in the check_mutex_lock_error function, and 
- * unlocks the same using the check_mutex_unlock_error function.
- * This is done to simply keep the function readable.
+ * required amount of meal. Instead of spinning over the seats, the
+ * referee looks at the root of the monitor heap, the seat with the
+ * earliest deadline, and sleeps until that deadline. A meal only moves
+ * a deadline later, so nobody can starve before the root does, and every
+ * seat is watched, not just the head of the table. He is woken up
+ * earlier only when the last philosopher gets full.
+ * The referee never sleeps past the earliest deadline, the "died." line
+ * is stamped the wake up latency of pthread_cond_timedwait after it:
+ * the timer slack, 50us by default, the kernel getting him a CPU, and
+ * the monitor mutex if a meal holds it for its O(log n) sift. While the
+ * threads runnable at the deadline are fewer than the CPUs that is about
+ * 0.1ms whatever the size of the table, 200 seats included, and the log
+ * adds up to 1ms by printing truncated milliseconds. With more runnable
+ * threads than CPUs the referee waits for the scheduler like everybody,
+ * a few milliseconds per thread ahead of him, which the program cannot
+ * bound. bench/latency.sh checks the first case.
  */
 static void	check_death_or_all_philo_full(t_shared *info)
 {
 	t_philo	*philo;
 
-	philo = info->table;
-	while (true)
+	if (pthread_mutex_lock(&info->monitor.mutex))
+	{
+		printf("\nError: Mutex lock failed.\n");
+		stop_simulation(info, SIM_ERROR);
+		return ;
+	}
+	while (!must_simulation_stop(info->table))
 	{
-		if (check_mutex_lock_error(info))
-			break ;
-		if (get_time_ms() - philo->last_meal_time >= info->time_to_die)
-		{
-			info->is_philo_dead = true;
-			pthread_mutex_unlock(&info->args_mutex);
-			report_philo_state(philo, "died.");
-			break ;
-		}
-		if (info->ate_max_meal == info->num_philos)
-		{
-			info->have_all_philos_eaten_max_meal = true;
-			printf("All philos have eaten %d meals.\n", info->num_meals);
-			pthread_mutex_unlock(&info->args_mutex);
-			break ;
-		}
-		if (check_mutex_unlock_error(info))
-			break ;
+		philo = info->monitor.heap[0];
+		if (info->monitor.all_full)
+			report_end(info, NULL, ALL_PHILOS_FULL);
+		else if (get_time_us() >= philo->deadline)
+			report_end(info, philo, PHILO_DIED);
+		else if (!wait_next_deadline(info))
+			stop_simulation(info, SIM_ERROR);
 	}
+	pthread_mutex_unlock(&info->monitor.mutex);
 }
 
 /*
  * This is the main thread, he simply referees the simulation by monitoring
  * if any of the philosophers are dead or if they have all eaten the 
  * required amount of meals.
+ * In virtual time he runs the whole simulation himself instead, with
+ * --monitor=sweep the sweepers watch the deadlines for him.
  * When the simulation ends, he simply waits to join the threads together
- * which automatically detaches the threads.
+ * which automatically detaches the threads, the workers of the pool
+ * when it runs the seats, then lets the writer print the last lines.
  */
 void	referee(t_shared *info)
 {
-	t_philo	*current;
+	unsigned int	i;
 
-	check_death_or_all_philo_full(info);
-	current = info->table;
-	while (true)
-	{
-		pthread_join(current->thread_id, NULL);
-		current = current->right;
-		if (current == info->table)
-			break ;
-	}
+	if (info->opt.virtual_time)
+		run_virtual_time(info);
+	else if (info->opt.monitor == MONITOR_SWEEP)
+		sweep_referee(info);
+	else
+		check_death_or_all_philo_full(info);
+	i = 0;
+	if (info->pool)
+		join_pool(info);
+	else
+		while (i < info->num_philos)
+			pthread_join(info->table[i++].thread_id, NULL);
+	finish_writer(info);
 }
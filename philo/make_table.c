@@ -6,146 +6,153 @@
 /*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/12/23 17:09:01 by sudaniel          #+#    #+#             */
-/*   Updated: 2025/01/07 07:18:11 by sudaniel         ###   ########.fr       */
+/*   Updated: 2026/10/18 03:55:38 by sudaniel         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /*
- * destroys all the initialized mutexes and frees all the nodes(seats) in 
- * the circular doubly linked list.
+ * destroys all the initialized mutexes, the seats and the chopsticks
+ * keep their memory, so --batch can lay the next table in it.
  */
-void	destroy_mutex_and_free_table(t_shared *info)
+void	clear_table(t_shared *info)
 {
-	t_philo	*current;
+	unsigned int	i;
 
-	current = info->table->right;
-	while (current != info->table)
-	{
-		pthread_mutex_destroy(&current->l_chopstick_mutex);
-		current = current->right;
-		free(current->left);
-	}
-	pthread_mutex_destroy(&info->table->l_chopstick_mutex);
-	free(info->table);
-	pthread_mutex_destroy(&info->args_mutex);
+	i = 0;
+	while (info->table && i < info->num_philos)
+		pthread_mutex_destroy(&info->chopsticks[i++].mutex);
+	pthread_mutex_destroy(&info->waiter);
+	pthread_mutex_destroy(&info->monitor.mutex);
+	pthread_cond_destroy(&info->monitor.wakeup);
+	STATS_FREE(info);
+	free(info->cpus);
+	info->cpus = NULL;
 }
 
 /*
- * A new_node created represents memory areas (seat at the table) 
- * for each of the philosophers.
- * If malloc fails or initialization of mutex fails, NULL is returned, else
- * a pointer to the node created is returned.
+ * destroys all the initialized mutexes and frees the table, the seats and
+ * the chopsticks are a single block, the monitor heap, the deadlines
+ * of --monitor=sweep, the classes of --profile and the logs of --record,
+ * which are written first.
  */
-static t_philo	*create_seat(t_shared *info, int i)
+void	destroy_mutex_and_free_table(t_shared *info)
 {
-	t_philo	*new_node;
-
-	new_node = (t_philo *)malloc(sizeof(t_philo));
-	if (!new_node)
-	{
-		printf("Error: Malloc failed.\n");
-		return (NULL);
-	}
-	new_node->philo_id = i;
-	if (pthread_mutex_init(&new_node->l_chopstick_mutex, NULL))
-	{
-		printf("Error: Mutex initialization failed.\n");
-		return (NULL);
-	}
-	new_node->times_eaten = 0;
-	new_node->last_meal_time = info->sim_start_time;
-	new_node->info = info;
-	new_node->left = NULL;
-	new_node->right = NULL;
-	return (new_node);
+	clear_table(info);
+	free(info->table);
+	info->table = NULL;
+	free(info->monitor.heap);
+	info->monitor.heap = NULL;
+	free(info->monitor.deadlines);
+	info->monitor.deadlines = NULL;
+	if (info->profiles != &info->uniform)
+		free(info->profiles);
+	info->profiles = NULL;
+	close_grant_log(info);
 }
 
 /*
- * Each seat created is added to the table which is a circular doubly
- * linked list.
+ * Fills the seat of the philosopher i (counted from 1) and initializes
+ * the chopstick to his left, which he owns. Every seat starts in the
+ * class of the command line, load_profile moves it. In the pool the ring is the
+ * one of whichever worker runs the seat, it is set by the worker.
+ * If the initialization of the mutex fails, 0 is returned, else 1.
  */
-static void	
-	add_seat_to_table(t_philo *new_seat, t_philo **table, t_philo **tail)
+static int	init_seat(t_shared *info, unsigned int i)
 {
-	if (!*table)
-	{
-		*table = new_seat;
-		*tail = new_seat;
-	}
-	else
-	{
-		new_seat->left = *tail;
-		(*tail)->right = new_seat;
-		*tail = new_seat;
-	}
+	t_philo	*seat;
+
+	seat = &info->table[i - 1];
+	seat->philo_id = i;
+	if (!init_chopstick(&info->chopsticks[i - 1], i))
+		return (0);
+	atomic_init(&seat->meal_seq, 0);
+	atomic_init(&seat->times_eaten, 0);
+	atomic_init(&seat->last_meal_time, info->sim_start_time);
+	seat->profile = &info->uniform;
+	seat->deadline = info->sim_start_time + info->time_to_die;
+	if (info->monitor.deadlines)
+		atomic_init(&info->monitor.deadlines[i - 1], seat->deadline);
+	seat->heap_pos = i - 1;
+	info->monitor.heap[i - 1] = seat;
+	seat->hungry = false;
+	atomic_init(&seat->grant, 0);
+	reset_think(seat);
+	seat->ring = NULL;
+	if (info->opt.engine == ENGINE_THREADS)
+		seat->ring = &info->writer->rings[i - 1];
+	seat->info = info;
+	return (1);
 }
 
 /*
- * Every seat on the table is assigned a right chopstick (mutex). This is to
- * help with competition and synchronization.
- * As each chopstick on the table is shared only between two philosophers. 
- * It is assumed that every chopstick to the left of a philosopher's seat
- * belongs to the philospher and he would need to acquire the chopstick
- * to his right to eat.
- * If the number of philosphers is just 1, obviously he cannot eat, we
- * assign the right chopstick to NULL.
+ * The table is one block of memory aligned on a cache line, the
+ * num_philos seats first, then the num_philos chopsticks. A seat and a
+ * chopstick are each a whole number of cache lines, so no two of them
+ * share a line, and within a seat the fields written by the philosopher
+ * and the ones the monitor heap moves are on lines of their own.
+ * The deadlines of --monitor=sweep are a dense array of their own, in
+ * seat order, a cache line holds the deadlines of 8 seats. Not in
+ * virtual time, the referee runs the seats himself there.
+ * Returns 0 if malloc fails, nothing is left allocated then, else 1.
  */
-static void	assign_right_chopsticks(t_philo *table, int num_philos)
+static int	alloc_table(t_shared *info)
 {
-	t_philo	*current;
+	void	*deadlines;
 
-	current = table;
-	while (true)
+	deadlines = NULL;
+	info->monitor.heap = malloc(sizeof(t_philo *) * info->num_philos);
+	if (!info->monitor.heap || posix_memalign((void **)&info->table,
+			CACHE_LINE, (sizeof(t_philo) + sizeof(t_chopstick))
+			* info->num_philos) || (info->opt.monitor == MONITOR_SWEEP
+			&& !info->opt.virtual_time && posix_memalign(&deadlines,
+				CACHE_LINE, sizeof(time_t) * info->num_philos)))
 	{
-		if (num_philos == 1)
-		{
-			current->r_chopstick_mutex = NULL;
-			break ;
-		}
-		current->r_chopstick_mutex = &current->right->l_chopstick_mutex;
-		current = current->right;
-		if (current == table)
-			break ;
+		printf("Error: Malloc failed.\n");
+		free(info->monitor.heap);
+		info->monitor.heap = NULL;
+		free(info->table);
+		info->table = NULL;
+		return (0);
 	}
+	info->monitor.deadlines = deadlines;
+	return (1);
 }
 
 /*
- * A node(seat) is created based on the number of philosophers specified.
- * It declares a circular doubly linked list table, seat for each
- * philosopher on the table and tail to keep track of the last seat(node)
- * in the list. Keeping track of the last node in the list makes adding 
- * to the end of the list a lot easier as we do not have to always loop
- * through the list searching for the last node when we want to add a node
- * to the list.
- * If the new_seat returned is NULL, all mutexes are destroyed, all nodes
- * in the list freed, and NULL is returned.
- * Else the created node(seat) is added to the list.
- * When done, a pointer to the head of the list is returned.
+ * Allocates the table, unless the table and the monitor heap are already
+ * set, then they are reused and must have room for num_philos seats.
+ * The neighbours of a seat are found by index, the seat after the last
+ * one is the first one.
+ * Every seat also goes into the monitor heap, as all deadlines are equal
+ * at the start any order is a valid heap, until --profile gives the
+ * seats their own times, see load_profile.
+ * If anything fails, everything is freed and NULL is returned, else a
+ * pointer to the first seat is returned.
  */
 t_philo	*make_table(t_shared *info)
 {
-	t_philo			*table;
-	t_philo			*new_seat;
-	t_philo			*tail;
 	unsigned int	i;
 
-	table = NULL;
-	tail = NULL;
-	i = 1;
-	while (i <= info->num_philos)
+	if (!info->table && !alloc_table(info))
+		return (NULL);
+	info->chopsticks = (t_chopstick *)(info->table + info->num_philos);
+	init_uniform(info);
+	i = 0;
+	while (++i <= info->num_philos)
 	{
-		new_seat = create_seat(info, i++);
-		if (!new_seat)
+		if (!init_seat(info, i))
 		{
+			info->num_philos = i - 1;
 			destroy_mutex_and_free_table(info);
 			return (NULL);
 		}
-		add_seat_to_table(new_seat, &table, &tail);
 	}
-	tail->right = table;
-	table->left = tail;
-	assign_right_chopsticks(table, info->num_philos);
-	return (table);
+	if (!load_profile(info))
+	{
+		destroy_mutex_and_free_table(info);
+		return (NULL);
+	}
+	return (info->table);
 }
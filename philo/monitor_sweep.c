@@ -0,0 +1,170 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   monitor_sweep.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:01:24 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:13:33 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The sweep saw a deadline that passed, the seats of the sweeper are
+ * looked at again one by one, a seat that ate since has a later deadline
+ * by now and is not reported. The referee is woken up, the simulation is
+ * over.
+ */
+static void	find_starved(t_sweeper *sweeper, time_t now)
+{
+	t_shared		*info;
+	unsigned int	i;
+
+	info = sweeper->info;
+	i = sweeper->first;
+	while (i < sweeper->end && atomic_load_explicit(
+			&info->monitor.deadlines[i], memory_order_relaxed) > now)
+		i++;
+	if (i == sweeper->end)
+		return ;
+	report_end(info, &info->table[i], PHILO_DIED);
+	if (pthread_mutex_lock(&info->monitor.mutex))
+		return ;
+	pthread_cond_signal(&info->monitor.wakeup);
+	pthread_mutex_unlock(&info->monitor.mutex);
+}
+
+/*
+ * A sweeper sweeps its seats for the earliest deadline and sleeps until
+ * then. A meal only moves a deadline later, so nobody of his can starve
+ * before it, when he wakes up the seat either ate or starved. A stop
+ * wakes him up as well. The detection latency is the wake up latency of
+ * the futex plus one sweep of his seats.
+ */
+static void	*sweep_routine(void *arg)
+{
+	t_sweeper	*sweeper;
+	t_shared	*info;
+	time_t		earliest;
+
+	sweeper = (t_sweeper *)arg;
+	info = sweeper->info;
+	while (atomic_load_explicit(&info->stop_epoch,
+			memory_order_acquire) == RUNNING)
+	{
+		earliest = sweeper->sweep(info->monitor.deadlines + sweeper->first,
+				sweeper->end - sweeper->first);
+		if (get_time_us() >= earliest)
+			find_starved(sweeper, get_time_us());
+		else
+			sleep_until(info, earliest);
+	}
+	return (NULL);
+}
+
+/*
+ * The seats are cut on multiples of 8 so every slice starts on a cache
+ * line of the deadlines, the last sweeper takes the rest. If a thread
+ * cannot be made the simulation stops, the ones already made are joined
+ * by the caller.
+ * Returns NULL if malloc fails.
+ */
+static t_sweeper	*start_sweepers(t_shared *info, unsigned int count)
+{
+	t_sweeper		*sweepers;
+	unsigned int	i;
+
+	sweepers = calloc(count, sizeof(t_sweeper));
+	i = 0;
+	while (sweepers && i < count)
+	{
+		sweepers[i].info = info;
+		sweepers[i].sweep = pick_sweep(SIMD_BEST);
+		sweepers[i].first = (size_t)i * info->num_philos / count / 8 * 8;
+		sweepers[i].end = (size_t)(i + 1) * info->num_philos / count / 8 * 8;
+		if (i + 1 == count)
+			sweepers[i].end = info->num_philos;
+		sweepers[i].started = !pthread_create(&sweepers[i].thread_id, NULL,
+				sweep_routine, &sweepers[i]);
+		if (!sweepers[i++].started)
+		{
+			printf("Error: pthread_create failed.\n");
+			stop_simulation(info, SIM_ERROR);
+			break ;
+		}
+	}
+	return (sweepers);
+}
+
+/*
+ * The deaths are the sweepers' business, the referee only waits for the
+ * last philosopher to get full, or for a sweeper to wake him up once the
+ * simulation stopped. Any other stop, an error of a philosopher, wakes
+ * nobody, the wait ends every REFEREE_POLL_US to look at the stop epoch.
+ */
+static void	wait_all_full(t_shared *info)
+{
+	struct timespec	until;
+	int				ret;
+
+	if (pthread_mutex_lock(&info->monitor.mutex))
+	{
+		printf("\nError: Mutex lock failed.\n");
+		stop_simulation(info, SIM_ERROR);
+		return ;
+	}
+	while (!must_simulation_stop(info->table))
+	{
+		if (info->monitor.all_full)
+		{
+			report_end(info, NULL, ALL_PHILOS_FULL);
+			continue ;
+		}
+		us_to_timespec(get_time_us() + REFEREE_POLL_US, &until);
+		ret = pthread_cond_timedwait(&info->monitor.wakeup,
+				&info->monitor.mutex, &until);
+		if (ret && ret != ETIMEDOUT)
+			stop_simulation(info, SIM_ERROR);
+	}
+	pthread_mutex_unlock(&info->monitor.mutex);
+}
+
+/*
+ * The referee of --monitor=sweep. Instead of the heap, the deadlines are
+ * kept in one dense array that monitor threads sweep with the widest
+ * vector loads the CPU has, see sweep_simd.c. A meal stores the new
+ * deadline without any lock, which is what the heap cost at large
+ * tables, at the price of a sweep of every seat per wakeup.
+ * --monitors=N sweepers, one by default, each watching at least 8 seats.
+ */
+void	sweep_referee(t_shared *info)
+{
+	t_sweeper		*sweepers;
+	unsigned int	count;
+	unsigned int	i;
+
+	count = info->opt.monitors;
+	if (count > info->num_philos / 8)
+		count = info->num_philos / 8;
+	if (!count)
+		count = 1;
+	sweepers = start_sweepers(info, count);
+	if (!sweepers)
+	{
+		printf("Error: Malloc failed.\n");
+		stop_simulation(info, SIM_ERROR);
+		return ;
+	}
+	wait_all_full(info);
+	i = 0;
+	while (i < count)
+	{
+		if (sweepers[i].started)
+			pthread_join(sweepers[i].thread_id, NULL);
+		i++;
+	}
+	free(sweepers);
+}
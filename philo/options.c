@@ -0,0 +1,179 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:08:33 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:29:55 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Checks that value is a number of at most max_len characters, with one
+ * decimal point when decimals is true. Returns false if it is not.
+ */
+static bool	is_number(const char *value, int max_len, bool decimals)
+{
+	const char	*c;
+	int			dots;
+
+	c = value;
+	dots = 0;
+	while ((*c >= '0' && *c <= '9') || (*c == '.' && decimals && !dots++))
+		c++;
+	return (c != value && !*c && c - value <= max_len);
+}
+
+/*
+ * Sets the options that take a value, the ones that take a file are in
+ * options_path.c. Returns false if arg is not one of them or its value is
+ * not valid, else true.
+ * --workers=N:		The number of workers of the pool, by default, or with 0,
+ * 					one per online CPU.
+ * --seed=N:		With --virtual-time, decides who goes first among the
+ * 					philosophers ready at the same instant, 0 by default.
+ * --horizon=MS:	With --virtual-time, ends the simulation once the
+ * 					virtual clock reaches MS milliseconds.
+ * --stack-size=KB:	The stack of a philosopher thread, STACK_SIZE by
+ * 					default.
+ * --spawners=N:	Creates the philosopher threads from N threads at
+ * 					once, by default the calling thread creates them.
+ * --monitors=N:	With --monitor=sweep, the number of sweepers, one by
+ * 					default.
+ */
+static bool	parse_value(t_options *opt, const char *arg)
+{
+	if (!strncmp(arg, "--workers=", 10) && is_number(arg + 10, 4, false))
+		opt->workers = ft_atoi(arg + 10);
+	else if (!strncmp(arg, "--seed=", 7) && is_number(arg + 7, 18, false))
+		opt->seed = ft_atol(arg + 7);
+	else if (!strncmp(arg, "--horizon=", 10)
+		&& is_number(arg + 10, 12, true))
+		opt->horizon = ms_to_us(arg + 10);
+	else if (!strncmp(arg, "--stack-size=", 13)
+		&& is_number(arg + 13, 7, false))
+		opt->stack_size = (size_t)ft_atoi(arg + 13) * 1024;
+	else if (!strncmp(arg, "--spawners=", 11)
+		&& is_number(arg + 11, 4, false))
+		opt->spawners = ft_atoi(arg + 11);
+	else if (!strncmp(arg, "--monitors=", 11) && is_number(arg + 11, 3, false))
+		opt->monitors = ft_atoi(arg + 11);
+	else
+		return (parse_path(opt, arg));
+	return (true);
+}
+
+/*
+ * Sets the strategy named name. Returns false if there is no such one.
+ * The ticket strategy is the hierarchy with ticket chopstick locks.
+ */
+static bool	parse_strategy(t_options *opt, const char *name)
+{
+	if (!strcmp(name, "default"))
+		opt->strategy = STRATEGY_DEFAULT;
+	else if (!strcmp(name, "hierarchy"))
+		opt->strategy = STRATEGY_HIERARCHY;
+	else if (!strcmp(name, "waiter"))
+		opt->strategy = STRATEGY_WAITER;
+	else if (!strcmp(name, "chandy-misra"))
+		opt->strategy = STRATEGY_CHANDY_MISRA;
+	else if (!strcmp(name, "ticket"))
+	{
+		opt->strategy = STRATEGY_TICKET;
+		opt->chopstick_lock = CHOPSTICK_TICKET;
+	}
+	else if (!strcmp(name, "edf"))
+		opt->strategy = STRATEGY_EDF;
+	else if (!strcmp(name, "schedule"))
+		opt->strategy = STRATEGY_SCHEDULE;
+	else
+		return (false);
+	return (true);
+}
+
+/*
+ * Sets the option named by arg. Returns false if it is not a known
+ * option, else true.
+ * --poll-sleep:	Sleep in 250us slices polling the stop epoch, as before
+ * 					sleeps became event driven. Kept to compare the two.
+ * --engine=threads:
+ * 					One thread per philosopher, the default.
+ * --engine=pool:	A fixed pool of workers runs all the seats, so tables
+ * 					far larger than the thread limit can be simulated.
+ * --virtual-time:	Runs the rules of the pool as a discrete event
+ * 					simulation on a virtual clock, in a single thread.
+ * --strategy=NAME:	How a philosopher thread gets his chopsticks, see
+ * 					t_strategy.
+ * --chopstick-lock=mutex|ticket:
+ * 					What a chopstick held for the meal is locked with,
+ * 					see lock_chopstick.
+ * --pin:			Pins runs of neighbouring seats to CPUs sharing caches.
+ * --pin-referee:	Also keeps a CPU for the referee and the writer.
+ */
+static bool	parse_option(t_options *opt, const char *arg)
+{
+	if (!strcmp(arg, "--poll-sleep"))
+		opt->poll_sleep = true;
+	else if (!strcmp(arg, "--engine=threads"))
+		opt->engine = ENGINE_THREADS;
+	else if (!strcmp(arg, "--engine=pool"))
+		opt->engine = ENGINE_POOL;
+	else if (!strcmp(arg, "--virtual-time"))
+		opt->virtual_time = true;
+	else if (!strncmp(arg, "--strategy=", 11))
+		return (parse_strategy(opt, arg + 11));
+	else if (!strcmp(arg, "--chopstick-lock=mutex"))
+		opt->chopstick_lock = CHOPSTICK_MUTEX;
+	else if (!strcmp(arg, "--chopstick-lock=ticket"))
+		opt->chopstick_lock = CHOPSTICK_TICKET;
+	else if (!strcmp(arg, "--pin"))
+		opt->pin = true;
+	else if (!strcmp(arg, "--pin-referee"))
+		opt->pin_referee = true;
+	else
+		return (parse_value(opt, arg));
+	return (true);
+}
+
+/*
+ * Options start with "--" and come before the numbers. They are consumed
+ * from argc and argv, so the caller sees the same arguments as without
+ * any option. Returns false on an unknown option, else true.
+ * sysconf returns -1 when it cannot tell the number of CPUs, that is
+ * clamped to one worker. Virtual time always runs on the pool, with a
+ * single worker. The pool has its own way with chopsticks, a strategy
+ * other than the default one needs philosopher threads.
+ * --batch takes no numbers, its tables run in virtual time, on as many
+ * threads as the pool would have workers, and publish no live stats and
+ * take no profile.
+ */
+bool	parse_options(int *argc, char ***argv, t_options *opt)
+{
+	long	cpus;
+
+	memset(opt, 0, sizeof(t_options));
+	while (*argc > 1 && !strncmp((*argv)[1], "--", 2))
+	{
+		if (!parse_option(opt, (*argv)[1]))
+			return (false);
+		(*argc)--;
+		(*argv)++;
+	}
+	opt->virtual_time = (opt->virtual_time || opt->batch);
+	if (opt->virtual_time)
+		opt->engine = ENGINE_POOL;
+	if ((opt->engine == ENGINE_POOL && opt->strategy != STRATEGY_DEFAULT)
+		|| (opt->batch && (*argc != 1 || opt->stats_shm || opt->profile)))
+		return (false);
+	opt->pin = (opt->pin || opt->pin_referee);
+	cpus = sysconf(_SC_NPROCESSORS_ONLN);
+	if (!opt->workers && cpus > 0)
+		opt->workers = cpus;
+	if (!opt->workers || (opt->virtual_time && !opt->batch))
+		opt->workers = 1;
+	return (true);
+}
@@ -0,0 +1,70 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   options_path.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:16:21 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:29:55 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Sets the options that pick a mode. Returns false if arg is not one of
+ * them, else true.
+ * --monitor=heap|sweep:
+ * 					How starving seats are found, see t_monitor_mode.
+ * 					Virtual time always uses the heap.
+ * --think=fixed|adaptive:
+ * 					How long a philosopher thinks, see t_think_mode.
+ */
+static bool	parse_mode(t_options *opt, const char *arg)
+{
+	if (!strcmp(arg, "--monitor=heap"))
+		opt->monitor = MONITOR_HEAP;
+	else if (!strcmp(arg, "--monitor=sweep"))
+		opt->monitor = MONITOR_SWEEP;
+	else if (!strcmp(arg, "--think=fixed"))
+		opt->think = THINK_FIXED;
+	else if (!strcmp(arg, "--think=adaptive"))
+		opt->think = THINK_ADAPTIVE;
+	else
+		return (false);
+	return (true);
+}
+
+/*
+ * Sets the options that name a file, or else a mode. Returns false if arg
+ * is neither or the name is empty, else true.
+ * --batch=FILE:	Runs a table for every line of FILE, see batch.c.
+ * --trace=FILE:	Stores the events in FILE as binary records instead of
+ * 					printing them, see trace.c and bench/trace_text.c.
+ * --stats-shm=FILE:	Publishes live stats in FILE, see stats_shm.c and
+ * 						bench/stats_top.c. Not with --batch.
+ * --profile=FILE:	Gives classes of seats their own times and meal
+ * 					targets, see profile.c. Not with --batch.
+ * --record=FILE:	Stores the order the chopsticks were granted in, see
+ * 					grant_log.c.
+ * --replay=FILE:	Grants the chopsticks in the order of a --record file.
+ */
+bool	parse_path(t_options *opt, const char *arg)
+{
+	if (!strncmp(arg, "--batch=", 8) && arg[8])
+		opt->batch = arg + 8;
+	else if (!strncmp(arg, "--trace=", 8) && arg[8])
+		opt->trace = arg + 8;
+	else if (!strncmp(arg, "--stats-shm=", 12) && arg[12])
+		opt->stats_shm = arg + 12;
+	else if (!strncmp(arg, "--profile=", 10) && arg[10])
+		opt->profile = arg + 10;
+	else if (!strncmp(arg, "--record=", 9) && arg[9])
+		opt->record = arg + 9;
+	else if (!strncmp(arg, "--replay=", 9) && arg[9])
+		opt->replay = arg + 9;
+	else
+		return (parse_mode(opt, arg));
+	return (true);
+}
@@ -6,35 +6,642 @@
 /*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2024/12/23 08:45:44 by sudaniel          #+#    #+#             */
-/*   Updated: 2025/01/07 07:59:25 by sudaniel         ###   ########.fr       */
+/*   Updated: 2026/10/18 04:33:35 by sudaniel         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #ifndef PHILO_H
 # define PHILO_H
 
+# define _GNU_SOURCE
+
 # include <stdio.h>
 # include <sys/time.h>
+# include <time.h>
 # include <pthread.h>
 # include <stdlib.h>
 # include <stdbool.h>
 # include <unistd.h>
+# include <stdatomic.h>
+# include <errno.h>
+# include <string.h>
+# include <sched.h>
+# include <limits.h>
+# include <linux/futex.h>
+# include <sys/syscall.h>
+# include <signal.h>
+# include <fcntl.h>
+# include <stdint.h>
+# include <sys/mman.h>
+
+/*
+ * t_stop lists the values of the stop_epoch in the shared info.
+ * RUNNING:			The simulation goes on.
+ * PHILO_DIED:		The referee found a starving philosopher.
+ * ALL_PHILOS_FULL:	Every philosopher ate at least num_meals meals.
+ * SIM_ERROR:		A pthread call failed, the simulation is aborted.
+ * TIME_UP:			The virtual clock reached --horizon.
+ */
+typedef enum e_stop
+{
+	RUNNING,
+	PHILO_DIED,
+	ALL_PHILOS_FULL,
+	SIM_ERROR,
+	TIME_UP
+}	t_stop;
+
+/*
+ * t_state lists what a philosopher reports. The two chopstick states
+ * only differ in their text, the first one taken is printed without "a".
+ * DIED and ALL_FULL are the referee's, one of them is the last line.
+ */
+typedef enum e_state
+{
+	FIRST_CHOPSTICK,
+	SECOND_CHOPSTICK,
+	EATING,
+	SLEEPING,
+	THINKING,
+	DIED,
+	ALL_FULL
+}	t_state;
+
+/*
+ * s_event is the fixed size record a state report is turned into,
+ * time is in microseconds since sim_start_time, it is printed in
+ * milliseconds.
+ */
+typedef struct s_event
+{
+	time_t			time;
+	unsigned int	philo_id;
+	int				state;
+}					t_event;
+
+# define RING_SIZE 128
+# define WORKER_RING_SIZE 65536
+
+# define TRACE_MAGIC "PHTRACE1"
+# define TRACE_SEAT_RECORDS 65536
+# define TRACE_SKIP 7
+# define TRACE_PAGE 4096
+
+/*
+ * s_record is an event of --trace as it is stored in the file, see
+ * trace.c.
+ * delta:	Microseconds since the previous record of the same region.
+ * code:	philo_id << 3 | state. A TRACE_SKIP state is no event, it
+ * 			only carries a delta too large for a single record.
+ */
+typedef struct s_record
+{
+	uint32_t	delta;
+	uint32_t	code;
+}				t_record;
+
+/*
+ * s_trace_header starts a --trace file. It is followed by the number of
+ * records of every region, num_regions uint64_t, and from the next
+ * TRACE_PAGE boundary by the records, region after region.
+ * dropped:	The records that could not be stored because the file could
+ * 			not grow, the trace is cut short when it is not 0.
+ */
+typedef struct s_trace_header
+{
+	char		magic[8];
+	uint32_t	num_regions;
+	int32_t		num_meals;
+	uint64_t	dropped;
+}				t_trace_header;
+
+/*
+ * s_extent is a full extent of a region that grew, see trace_grow.c.
+ */
+typedef struct s_extent
+{
+	t_record	*records;
+	size_t		num_records;
+}				t_extent;
+
+/*
+ * s_ring is a single producer, single consumer queue of events.
+ * head:		Only written by the producer (a philosopher, a worker of
+ * 				the pool or the referee).
+ * tail:		Only written by the writer thread.
+ * in_flight:	Set by the producer while he reads the clock and pushes.
+ * 				The writer waits for it to be clear before draining, so
+ * 				any event pushed later has a later time than the writer's
+ * 				watermark, which is what keeps the output in time order.
+ * records:		With --trace, the producer's region of the trace file,
+ * 				his events go there instead, see trace_event. Only the
+ * 				producer touches it and the fields after it.
+ * extents:		The full extents of the region before records, in the
+ * 				order they were filled, num_extents of them.
+ */
+typedef struct s_ring
+{
+	atomic_uint		head;
+	atomic_uint		tail;
+	atomic_bool		in_flight;
+	unsigned int	size;
+	t_event			*events;
+	t_record		*records;
+	size_t			num_records;
+	size_t			max_records;
+	t_extent		*extents;
+	size_t			num_extents;
+	size_t			dropped;
+	time_t			last_time;
+}					t_ring;
+
+/*
+ * s_pending is an event drained by the writer, order is the drain order
+ * which keeps events of a ring in the order they were pushed when times
+ * are equal.
+ */
+typedef struct s_pending
+{
+	t_event			event;
+	size_t			order;
+}					t_pending;
+
+# define OUT_BUF_SIZE 65536
+
+/*
+ * s_writer is the thread that turns events into text.
+ * rings:		One ring per philosopher, or per worker of the pool, plus
+ * 				the referee's at the end.
+ * events:		The storage of every ring, in one block.
+ * pending:		Drained events not printed yet, because a later drain
+ * 				could still bring an earlier one.
+ * buf:			Lines are formatted in here and written with one
+ * 				write(2) per batch.
+ * done:		Set by the referee once all philosophers are joined.
+ * trace:		The --trace file mapped in memory, trace_size bytes of
+ * 				it, trace_fd its descriptor. trace_end is the size of the
+ * 				file, the extents of the regions that grew are mapped
+ * 				past trace_size, trace_lock orders the producers growing
+ * 				it.
+ */
+typedef struct s_writer
+{
+	pthread_t		thread_id;
+	t_ring			*rings;
+	t_event			*events;
+	unsigned int	num_rings;
+	t_pending		*pending;
+	size_t			num_pending;
+	size_t			max_pending;
+	size_t			order;
+	int				num_meals;
+	char			buf[OUT_BUF_SIZE];
+	size_t			len;
+	atomic_bool		done;
+	char			*trace;
+	size_t			trace_size;
+	size_t			trace_end;
+	int				trace_fd;
+	pthread_mutex_t	trace_lock;
+}					t_writer;
+
+# define CACHE_LINE 64
+
+/*
+ * s_chopstick is padded to a whole cache line, so taking a chopstick
+ * never invalidates the line of the next one or of a seat.
+ * taken and waiter are used by the pool, where the mutex is held just
+ * long enough to look at them, see pool_chopsticks.c, and by the
+ * strategies that do not keep the mutex for the meal, see strategy.c.
+ * dirty and owner:	The fork of --strategy=chandy-misra, owner is the
+ * 					philo_id of the seat holding it.
+ * next_ticket and now_serving:
+ * 					The ticket lock of --chopstick-lock=ticket.
+ * All of it still fits the one line.
+ */
+typedef struct s_chopstick
+{
+	_Alignas(CACHE_LINE) pthread_mutex_t	mutex;
+	bool									taken;
+	bool									dirty;
+	unsigned int							owner;
+	struct s_philo							*waiter;
+	atomic_int								next_ticket;
+	atomic_int								now_serving;
+}											t_chopstick;
+
+/*
+ * s_monitor is what the referee sleeps on.
+ * mutex:		Guards everything in the monitor and the deadline and
+ * 				heap_pos fields of every seat.
+ * wakeup:		The referee waits on it until the earliest deadline, a
+ * 				philosopher signals it when the referee must look earlier.
+ * heap:		A binary min heap of all seats ordered by deadline, the
+ * 				root is the next philosopher that could starve.
+ * all_full:	Set by the philosopher whose meal makes ate_max_meal
+ * 				reach num_philos.
+ * deadlines:	With --monitor=sweep, the deadline of every seat in one
+ * 				dense array, in seat order, instead of the heap. Written
+ * 				by the seat with a relaxed store, no lock is taken.
+ */
+typedef struct s_monitor
+{
+	pthread_mutex_t	mutex;
+	pthread_cond_t	wakeup;
+	struct s_philo	**heap;
+	bool			all_full;
+	_Atomic time_t	*deadlines;
+}					t_monitor;
+
+/*
+ * The vector sweeps read the deadlines with plain loads, the thread
+ * sanitizer only gets the scalar one, see pick_sweep.
+ */
+# ifdef __SANITIZE_THREAD__
+#  define SWEEP_SANITIZED 1
+# else
+#  define SWEEP_SANITIZED 0
+# endif
+
+/*
+ * t_sweep returns the earliest of count deadlines, see sweep_simd.c.
+ */
+typedef time_t	(*t_sweep)(_Atomic time_t *deadlines, size_t count);
+
+/*
+ * t_simd names the ways to sweep the deadlines, SIMD_BEST is the best
+ * one the CPU has.
+ */
+typedef enum e_simd
+{
+	SIMD_BEST,
+	SIMD_AVX2,
+	SIMD_SSE42,
+	SIMD_SCALAR
+}	t_simd;
+
+/*
+ * s_sweeper is a monitor thread of --monitor=sweep, it watches the seats
+ * first to end.
+ * started:	Whether its thread was created, and must be joined.
+ */
+typedef struct s_sweeper
+{
+	pthread_t		thread_id;
+	struct s_shared	*info;
+	t_sweep			sweep;
+	unsigned int	first;
+	unsigned int	end;
+	bool			started;
+}					t_sweeper;
+
+/*
+ * s_grant_log is what --record and --replay keep of a seat, and of the
+ * chopstick left of it, see grant_log.c.
+ * stamps:		Every chopstick the seat got, in order, as the number of
+ * 				times that chopstick had been granted before, shifted left
+ * 				by one, the low bit set for the right chopstick.
+ * count, size:	How many stamps there are, and room for.
+ * next:		With --replay, the stamp the seat waits for next, replayed
+ * 				how many of them it got at the recorded turn.
+ * granted:		How many times the chopstick left of the seat was granted,
+ * 				only written by whoever holds it, on a line of its own.
+ */
+typedef struct s_grant_log
+{
+	_Alignas(CACHE_LINE) uint32_t	*stamps;
+	size_t							count;
+	size_t							size;
+	size_t							next;
+	size_t							replayed;
+	_Alignas(CACHE_LINE) atomic_int	granted;
+}									t_grant_log;
+
+# define GRANT_MAGIC "PHGRANT1"
+
+# define SHM_MAGIC "PHSTATS1"
+# define SHM_VERSION 2
+
+/*
+ * s_shm_header starts the file of --stats-shm, see stats_shm.c and
+ * bench/stats_top.c. The times are in microseconds, now and last_meal
+ * since the start of the simulation.
+ * version:			SHM_VERSION once everything before it is set, 0 until
+ * 					then. A reader waits for it before reading the rest.
+ * now:				The clock of the simulation, moved by the writer thread
+ * 					about every millisecond, or by the virtual clock.
+ * ate_max_meal:	A copy of the one of the shared info.
+ * stop:			The stop_epoch, one of the t_stop values.
+ */
+typedef struct s_shm_header
+{
+	char									magic[8];
+	atomic_uint								version;
+	uint32_t								num_philos;
+	int64_t									time_to_die;
+	int64_t									time_to_eat;
+	int64_t									time_to_sleep;
+	int32_t									num_meals;
+	int32_t									pid;
+	_Alignas(CACHE_LINE) _Atomic int64_t	now;
+	atomic_uint								ate_max_meal;
+	atomic_int								stop;
+}											t_shm_header;
+
+/*
+ * s_shm_seat is a seat of --stats-shm, one cache line written only by
+ * the thread running the seat. seq is a sequence lock like the meal_seq
+ * of the seat, odd while times_eaten and last_meal are written. state is
+ * the last t_state the seat reported. time_to_die and num_meals are the
+ * ones of the class of the seat with --profile, set before version.
+ */
+typedef struct s_shm_seat
+{
+	_Alignas(CACHE_LINE) atomic_uint	seq;
+	atomic_int							state;
+	atomic_int							times_eaten;
+	_Atomic int64_t						last_meal;
+	int64_t								time_to_die;
+	int32_t								num_meals;
+}										t_shm_seat;
+
+/*
+ * t_engine is what runs the philosophers.
+ * ENGINE_THREADS:	One thread per philosopher, the original way.
+ * ENGINE_POOL:		A fixed pool of workers runs every seat as a state
+ * 					machine, see pool.c.
+ */
+typedef enum e_engine
+{
+	ENGINE_THREADS,
+	ENGINE_POOL
+}	t_engine;
+
+/*
+ * t_strategy is how a philosopher thread gets his two chopsticks, see
+ * strategy.c.
+ * STRATEGY_DEFAULT:	Left then right, even seats start 5ms late.
+ * STRATEGY_HIERARCHY:	The lower numbered chopstick first.
+ * STRATEGY_WAITER:		A waiter hands out both chopsticks at once.
+ * STRATEGY_CHANDY_MISRA:
+ * 						Clean and dirty forks, see strategy_chandy_misra.c.
+ * STRATEGY_TICKET:		The hierarchy, with --chopstick-lock=ticket.
+ * STRATEGY_EDF:		The waiter, serving the seat that starves first,
+ * 						see strategy_edf.c.
+ * STRATEGY_SCHEDULE:	Every seat eats at the times of a plan made from the
+ * 						numbers, see strategy_schedule.c.
+ */
+typedef enum e_strategy
+{
+	STRATEGY_DEFAULT,
+	STRATEGY_HIERARCHY,
+	STRATEGY_WAITER,
+	STRATEGY_CHANDY_MISRA,
+	STRATEGY_TICKET,
+	STRATEGY_EDF,
+	STRATEGY_SCHEDULE
+}	t_strategy;
+
+/*
+ * t_chopstick_lock is what a chopstick held for a meal is locked with,
+ * see chopstick_lock.c.
+ * CHOPSTICK_MUTEX:		Its pthread mutex, the default.
+ * CHOPSTICK_TICKET:	A ticket lock that spins near the end of the
+ * 						holder's meal and sleeps on a futex otherwise.
+ */
+typedef enum e_chopstick_lock
+{
+	CHOPSTICK_MUTEX,
+	CHOPSTICK_TICKET
+}	t_chopstick_lock;
+
+/*
+ * t_monitor_mode is how starving seats are found.
+ * MONITOR_HEAP:	The referee sleeps on the deadline heap, the default.
+ * MONITOR_SWEEP:	Monitor threads sweep the dense deadlines, see
+ * 					monitor_sweep.c.
+ */
+typedef enum e_monitor_mode
+{
+	MONITOR_HEAP,
+	MONITOR_SWEEP
+}	t_monitor_mode;
+
+/*
+ * t_think_mode is how long a philosopher thinks after his sleep.
+ * THINK_FIXED:		Half of what is left of time_to_die, none below 10ms and
+ * 					100ms from 200ms on, see think_time. The default.
+ * THINK_ADAPTIVE:	Every seat steers its own think time by the wait for
+ * 					chopsticks and the slack it measured, see think.c.
+ */
+typedef enum e_think_mode
+{
+	THINK_FIXED,
+	THINK_ADAPTIVE
+}	t_think_mode;
+
+# define THINK_MARGIN 8
+# define THINK_SETTLE 500
+
+# define CHOPSTICK_SPIN_US 100
+# define REFEREE_POLL_US 10000
+# define STACK_SIZE 262144
+
+/*
+ * s_options holds the command line options, see options.c.
+ */
+typedef struct s_options
+{
+	bool				poll_sleep;
+	t_engine			engine;
+	unsigned int		workers;
+	bool				virtual_time;
+	unsigned long		seed;
+	time_t				horizon;
+	t_strategy			strategy;
+	t_chopstick_lock	chopstick_lock;
+	bool				pin;
+	bool				pin_referee;
+	const char			*batch;
+	const char			*trace;
+	const char			*stats_shm;
+	const char			*profile;
+	const char			*record;
+	const char			*replay;
+	size_t				stack_size;
+	unsigned int		spawners;
+	t_monitor_mode		monitor;
+	unsigned int		monitors;
+	t_think_mode		think;
+}						t_options;
+
+/*
+ * t_step is where a seat of the pool resumes when it is run again.
+ * STEP_LEFT:		Wants the left chopstick.
+ * STEP_GOT_LEFT:	Holds the left chopstick, wants the right one.
+ * STEP_GOT_RIGHT:	Holds both, starts eating.
+ * STEP_ATE:		Done eating, puts the chopsticks down and sleeps.
+ * STEP_SLEPT:		Done sleeping, starts thinking.
+ */
+typedef enum e_step
+{
+	STEP_LEFT,
+	STEP_GOT_LEFT,
+	STEP_GOT_RIGHT,
+	STEP_ATE,
+	STEP_SLEPT
+}	t_step;
+
+/*
+ * s_worker is a thread of the pool.
+ * ring:		The ring every seat it runs reports into.
+ * lock:		Guards the ready queue, other workers steal from it.
+ * ready:		A circular queue of the seats that can run now, the owner
+ * 				takes from the front, thieves from the back.
+ * timers:		A binary min heap of the seats waiting for the end of a
+ * 				meal, a sleep or a think, by wake. Only the owner touches it.
+ * nudge:		The futex word the worker sleeps on when it is idle.
+ * idle:		Raised while it sleeps, so a busy worker can wake it up.
+ */
+typedef struct s_worker
+{
+	_Alignas(CACHE_LINE) pthread_t	thread_id;
+	struct s_shared					*info;
+	t_ring							*ring;
+	pthread_mutex_t					lock;
+	struct s_philo					**ready;
+	unsigned int					ready_head;
+	unsigned int					ready_len;
+	unsigned int					ready_cap;
+	struct s_philo					**timers;
+	unsigned int					num_timers;
+	unsigned int					timers_cap;
+	atomic_int						nudge;
+	atomic_bool						idle;
+}									t_worker;
+
+/*
+ * s_pool is the M:N engine, num_workers threads for all the seats.
+ * num_started:	How many of the workers were created, and must be joined.
+ * num_idle:	How many workers are about to sleep or sleeping, only a
+ * 				hint to skip looking for one when there is none.
+ */
+typedef struct s_pool
+{
+	t_worker		*workers;
+	unsigned int	num_workers;
+	unsigned int	num_started;
+	atomic_uint		num_idle;
+}					t_pool;
+
+/*
+ * t_lock names the locks a philosopher waits for, see stats_record.c.
+ * LOCK_MONITOR is the mutex of the monitor.
+ */
+typedef enum e_lock
+{
+	LOCK_LEFT,
+	LOCK_RIGHT,
+	LOCK_MONITOR,
+	NUM_LOCKS
+}	t_lock;
+
+# ifdef PHILO_STATS
+
+/*
+ * s_lock_stats is what a seat measured of one lock, in microseconds.
+ * locked_at is when the seat got it last, to measure how long it holds
+ * it, nobody else ever reads it.
+ */
+typedef struct s_lock_stats
+{
+	atomic_long		count;
+	atomic_long		wait;
+	atomic_long		max_wait;
+	atomic_long		hold;
+	time_t			locked_at;
+}					t_lock_stats;
+
+# define STATS_BUCKETS 24
+# define STATS_SEATS 32
+
+/*
+ * s_seat_stats is the buffer of one seat, only the thread running the
+ * seat writes it, the dump only reads. intervals is a histogram of the
+ * time between two meals, bucket i counts the ones of 2^i to 2^(i+1)
+ * microseconds.
+ */
+typedef struct s_seat_stats
+{
+	_Alignas(CACHE_LINE) t_lock_stats	locks[NUM_LOCKS];
+	atomic_long							sleeps;
+	atomic_long							overslept;
+	atomic_long							max_overslept;
+	atomic_long							intervals[STATS_BUCKETS];
+}										t_seat_stats;
+
+# endif
+
+/*
+ * s_profile is a class of seats with their own times, in microseconds,
+ * and meal target, -1 for none. Without --profile every seat is in the
+ * one class of the command line, see profile.c.
+ * line:		The line of the profile file, 0 for the command line.
+ * first, last, step:
+ * 				The seats of the line, first to last every step seats.
+ * seats, meals:	How many seats ended up in the class and how many
+ * 				meals they ate, counted by print_profile.
+ */
+typedef struct s_profile
+{
+	time_t			time_to_die;
+	time_t			time_to_eat;
+	time_t			time_to_sleep;
+	int				num_meals;
+	unsigned int	line;
+	unsigned int	first;
+	unsigned int	last;
+	unsigned int	step;
+	unsigned int	seats;
+	long			meals;
+}					t_profile;
 
 /*
  * s_shared contains information that are common to all philosophers
- * when created.
+ * when created. Every time in it, and in the seats, is in microseconds of
+ * CLOCK_MONOTONIC, the times on the command line are in milliseconds.
+ * coarse_slack:	The resolution of the coarse clock, see timebase.c.
+ * num_meals:		The fewest meals any seat must eat, -1 if a seat has no
+ * 					target. It is what the all full line prints.
+ * opt:				The command line options.
+ * virtual_now:		The virtual clock with --virtual-time, see sim_now.
  * ate_max_meal:	Every philosopher increments it when they have eaten
- * 					at least the number of meals when specified(num_meals).
- * args_mutex:		Used to allow access to threads reading and writing
- * 					to the variables in the shared struct.
- * is_philo_dead
- * and 
- * have_all_philos_eaten_max_meal:
- * 					These are flags every philosopher reads/checks to
- * 					know if the simulation should stop or not.
- * 					The main thread is reponsible for setting these flags.
- * table:			table is a pointer to the head seat(node) of a
- * 					circular linked list.
+ * 					at least the number of meals when specified(num_meals),
+ * 					with an atomic add, see check_num_meals.
+ * waiter:			The mutex of --strategy=waiter and edf, it guards hungry
+ * 					and the taken chopsticks.
+ * stop_epoch:		Holds one of the t_stop values. It is written once,
+ * 					by whoever stops the simulation first, and read by
+ * 					every philosopher without taking any lock.
+ * start_gate:		0 until the simulation starts, every thread it made
+ * 					waits for it to be 1, see open_start_gate.
+ * startup:			How long it took to make those threads.
+ * monitor:		The deadline heap the referee sleeps on.
+ * writer:			The output thread and the rings of events it prints.
+ * table:			The array of the num_philos seats, see make_table.
+ * chopsticks:		The array of the num_philos chopsticks, allocated in
+ * 					the same block right after the seats.
+ * pool:			The workers with --engine=pool, else NULL.
+ * cpus:			With --pin, the CPUs in the order of their caches, the
+ * 					num_cpus first ones run the philosophers, see
+ * 					setup_pinning for how a CPU is stored.
+ * shm:			With --stats-shm, the mapped file, else NULL. shm_seats
+ * 					are its seats, right after the header.
+ * stats:			One buffer per seat, only built with PHILO_STATS.
+ * uniform:		The class of the numbers of the command line.
+ * profiles:		The classes of the seats, num_profiles of them, the first
+ * 					one is uniform, see load_profile.
+ * grants:			With --record or --replay, a log per seat, else NULL.
  */
 typedef struct s_shared
 {
@@ -44,22 +651,53 @@ typedef struct s_shared
 	time_t			time_to_sleep;
 	int				num_meals;
 	time_t			sim_start_time;
-	unsigned int	ate_max_meal;
-	pthread_mutex_t	args_mutex;
-	bool			is_philo_dead;
-	bool			have_all_philos_eaten_max_meal;
+	time_t			coarse_slack;
+	t_options		opt;
+	time_t			virtual_now;
+	atomic_uint		ate_max_meal;
+	pthread_mutex_t	waiter;
+	atomic_int		stop_epoch;
+	atomic_int		start_gate;
+	time_t			startup;
+	t_monitor		monitor;
+	t_writer		*writer;
 	struct s_philo	*table;
+	t_chopstick		*chopsticks;
+	t_pool			*pool;
+	long			*cpus;
+	int				num_cpus;
+	t_shm_header	*shm;
+	t_shm_seat		*shm_seats;
+# ifdef PHILO_STATS
+	t_seat_stats	*stats;
+# endif
+	t_profile		uniform;
+	t_profile		*profiles;
+	unsigned int	num_profiles;
+	t_grant_log		*grants;
 }					t_shared;
 
 /*
  * thread_id:	Every philosopher upon created is assigned an id by the 
- * 				pthread_create funtion.
- * philo_id:	Every philo is given an id ranging from 1 to num_philos.
- * l_chopstick_mutex and r_chopstick_mutex
+ * 				pthread_create funtion. It is unused in the pool.
+ * philo_id:	Every philo is given an id ranging from 1 to num_philos,
+ * 				his seat is table[philo_id - 1].
  * 				Each philosopher must acqurire a left and right chopstick
- * 				before they can eat. Notice that r_chopstick_mutex is
- * 				a pointer, since the number of chopsticks equals the number
- * 				of philosophers.
+ * 				before they can eat, they are found by index with
+ * 				l_chopstick and r_chopstick, since the number of
+ * 				chopsticks equals the number of philosophers.
+ * ring:		The event ring the philosopher reports his states into, in
+ * 				the pool the one of the worker that runs him.
+ * step:		In the pool, what the seat does next, see t_step.
+ * wake:		In the pool, when the timer of the seat fires.
+ * info:		Each philospher gets a pointer to the shared info, this is
+ * 				important, because they need to increment the ate_max_meal
+ * 				variable and need to read the stop_epoch.
+ * profile:		The times and the meal target of the seat, see t_profile.
+ * meal_seq:	A per seat sequence lock guarding times_eaten and
+ * 				last_meal_time. It is odd while the philosopher writes
+ * 				them, so the referee can take a consistent snapshot
+ * 				without ever blocking the philosopher.
  * times_eaten:	Each philospher reports the number of times it has eaten
  * 				this is necessary when number of meals to eat is specified.
  * last_meal_time:
@@ -67,28 +705,116 @@ typedef struct s_shared
  * 				time_to_die, therefor, everytime a philospher eats, he
  * 				needs to record this time, which would be used to check
  * 				against time_to_die the next time he eats.
- * info:		Each philospher gets a pointer to the shared info, this is
- * 				important, because they need to write to the ate_max_meal
- * 				variable and need to read/check the is_philo_dead and
- * 				have_all_philos_eaten_max_meal variables.
- * left and right:
- * 				Each philosopher has a pointer to his left and right 
- * 				philosphers, this is because we are implementing a 
- * 				circular doubly linked list. Yes, the philosophers
- * 				do not communicate.
+ * deadline:	last_meal_time + the time_to_die of his profile, the key of
+ * 				the seat in the monitor heap, and heap_pos its index in
+ * 				there. Both are
+ * 				guarded by the monitor mutex.
+ * hungry:		With --strategy=waiter or edf, the seat waits to be served.
+ * grant:		Bumped by the neighbour who hands the seat its chopsticks,
+ * 				the seat blocks on it meanwhile, see wait_for_grant.
+ * think, hungry_at and ate_at:
+ * 				The think time of --think=adaptive, when the seat last got
+ * 				hungry and when the meal before the last one started, 0
+ * 				before the first one.
+ * 				Only the philosopher touches them, once a cycle.
+ * A seat is two cache lines: the first one is only written by the
+ * philosopher himself, the second one holds what the monitor heap moves
+ * around when other philosophers eat. The first one is full, the state
+ * of --think=adaptive takes the room left in the second one, it is
+ * written no more often than the deadline next to it.
  */
 typedef struct s_philo
+{
+	_Alignas(CACHE_LINE) pthread_t	thread_id;
+	unsigned int					philo_id;
+	t_step							step;
+	t_ring							*ring;
+	t_shared						*info;
+	const t_profile					*profile;
+	atomic_uint						meal_seq;
+	atomic_int						times_eaten;
+	_Atomic time_t					last_meal_time;
+	time_t							wake;
+	_Alignas(CACHE_LINE) time_t		deadline;
+	unsigned int					heap_pos;
+	bool							hungry;
+	atomic_int						grant;
+	time_t							think;
+	time_t							hungry_at;
+	time_t							ate_at;
+}									t_philo;
+
+# define BATCH_HORIZON 60000000
+
+/*
+ * s_result is the one line a table of --batch prints, see batch.c.
+ * text:	The arguments of the table, freed once it ran.
+ * line:	The line of the batch file the table was read from.
+ * done:	Set once the table ran, the results are printed in line order.
+ * outcome:	Why the table stopped, SIM_ERROR if its line was not valid.
+ * time:	When it stopped, in microseconds of the virtual clock.
+ * meals:	The meals finished by all the seats of the table.
+ */
+typedef struct s_result
+{
+	char			*text;
+	unsigned int	line;
+	bool			done;
+	t_stop			outcome;
+	time_t			time;
+	long			meals;
+}					t_result;
+
+/*
+ * s_batch is what the runners of --batch share.
+ * opt:			The options every table runs with.
+ * results:		One per table, in the order of the file.
+ * next:		The index of the next table a runner takes.
+ * print:		Guards done of the results and printed.
+ * printed:		How many results were printed, they go out in order.
+ */
+typedef struct s_batch
+{
+	t_options		opt;
+	t_result		*results;
+	unsigned int	num_lines;
+	unsigned int	max_lines;
+	atomic_uint		next;
+	pthread_mutex_t	print;
+	unsigned int	printed;
+}					t_batch;
+
+/*
+ * s_runner is a thread of --batch, it runs one table after the other.
+ * table, heap and capacity are the seats, the monitor heap and how many
+ * seats they have room for, kept from one table to the next.
+ */
+typedef struct s_runner
 {
 	pthread_t		thread_id;
-	unsigned int	philo_id;
-	pthread_mutex_t	l_chopstick_mutex;
-	pthread_mutex_t	*r_chopstick_mutex;
-	int				times_eaten;
-	time_t			last_meal_time;
-	t_shared		*info;
-	struct s_philo	*left;
-	struct s_philo	*right;
-}					t_philo;
+	t_batch			*batch;
+	t_philo			*table;
+	t_philo			**heap;
+	unsigned int	capacity;
+}					t_runner;
+
+/*
+ * s_spawner creates the philosopher threads of the seats first to end,
+ * with --spawners=N each of the N slices of the table has its own.
+ * created:	How many of them it created, from first on.
+ * started:	Whether it runs in a thread of its own, to be joined.
+ */
+typedef struct s_spawner
+{
+	pthread_t		thread_id;
+	t_philo			*table;
+	pthread_attr_t	*attr;
+	unsigned int	first;
+	unsigned int	end;
+	unsigned int	created;
+	bool			started;
+	bool			failed;
+}					t_spawner;
 
 //	ft_atoi:	Converts the numerical characters in a string (str) to integers
 //				and returns the integer.
@@ -97,49 +823,485 @@ int		ft_atoi(const char *str);
 //	ft_atol:	Similar to ft_atoi, but retruns a long integer.
 long	ft_atol(const char *str);
 
-// get_time_ms:	Returns the time of day in milliseconds upon success,
-// 				else it returns 0.
-time_t	get_time_ms(void);
+// get_time_us:	Returns the time of CLOCK_MONOTONIC in microseconds upon
+// 				success, else it returns 0.
+time_t	get_time_us(void);
 
-//	make_table:	Creates a circular doubly linked list, returns NULL
-//				if anything fails else, returns a pointer to the created list.
+// get_coarse_time_us:	Same as get_time_us but from the cheap, coarse
+// 						clock, it may lag behind by up to coarse_slack.
+time_t	get_coarse_time_us(void);
+
+// get_coarse_slack_us:	Returns the resolution of the coarse clock.
+time_t	get_coarse_slack_us(void);
+
+// ms_to_us:	Converts a number of milliseconds, with up to three
+// 				decimals, to microseconds.
+time_t	ms_to_us(const char *str);
+
+// us_to_timespec:	Converts microseconds to a timespec.
+void	us_to_timespec(time_t us, struct timespec *ts);
+
+// sim_now:	Returns the time of the simulation in microseconds, the
+// 			virtual clock with --virtual-time, else get_time_us.
+time_t	sim_now(t_shared *info);
+
+// check_args_and_init:	Validates the four or five numbers of argv and
+// 						initializes the shared info with them. Returns
+// 						false if they are not valid or a mutex fails.
+bool	check_args_and_init(char **argv, t_shared *info);
+
+//	make_table:	Allocates the seats and the chopsticks in one block, returns
+//				NULL if anything fails else, returns a pointer to the first
+//				seat.
 t_philo	*make_table(t_shared *info);
 
+// init_uniform:	Makes the numbers of the command line the class every
+// 					seat starts in.
+void	init_uniform(t_shared *info);
+
+// load_profile:	With --profile, moves the seats into the classes of the
+// 					file, see profile.c. Returns 0 if it is not valid.
+int		load_profile(t_shared *info);
+
+// read_profile:	Adds a class for every line of the profile file, see
+// 					profile_parse.c. Returns 0 if it is not valid.
+int		read_profile(t_shared *info, const char *path);
+
+// print_profile:	With --profile, prints the meals of every class on
+// 					stderr once the simulation ended.
+void	print_profile(t_shared *info);
+
+//	l_chopstick and r_chopstick:	Return the chopstick to the left and to
+//									the right of a philosopher, computed
+//									from his seat index. r_chopstick is
+//									NULL when he is alone at the table.
+t_chopstick	*l_chopstick(t_philo *philo);
+t_chopstick	*r_chopstick(t_philo *philo);
+
+//	clear_table:	Destroys all mutexes initialized in the shared info and
+//					the table, but keeps the table allocated.
+void	clear_table(t_shared *info);
+
 //	destroy_mutex_and_free_table:	Destroys all mutexes initialized 
-//									in the shared info and nodes in the
-//									circular linked list.
+//									in the shared info and the table,
+//									and frees the table.
 //									It returns nothing.
 void	destroy_mutex_and_free_table(t_shared *info);
 
+// philo_routine:	The start routine of a philosopher thread.
+void	*philo_routine(void *arg);
+
 // create_philos:	Creates threads for the specified number of philos, amd
-// 					assigns the threads to their start routine.
-// 					Returns 0 if thread creation fails else returns 1.
+// 					assigns the threads to their start routine, they
+// 					wait at the start gate. Returns 0 if thread creation
+// 					fails, the ones created are stopped and joined then,
+// 					else returns 1.
 int		create_philos(t_philo *table);
 
-// philo_sleeps:	A philosopher sleeps milliseconds time, waking up
-// 					regularly for a short while to check if the simulation
-// 					must stop or not. If the simulation must stop or an
-// 					error case occured it returns 0, else it returns 1.
-int		philo_sleeps(t_philo *philo, time_t milliseconds);
+// setup_pinning:	Reads the CPU topology for --pin and pins the referee
+// 					with --pin-referee. Returns 0 if it fails, else 1.
+int		setup_pinning(t_shared *info);
+
+// pin_seat:	With --pin, pins the thread i of count to its CPU.
+void	pin_seat(t_shared *info, pthread_t thread, unsigned int i,
+			unsigned int count);
+
+// take_chopsticks:	The default strategy, left then right. Returns 0 if the
+// 					simulation stopped or an error occured, else 1.
+int		take_chopsticks(t_philo *philo);
+
+// init_chopstick:	Initializes the chopstick left of the seat i for every
+// 					strategy. Returns 0 if the mutex fails, else 1.
+int		init_chopstick(t_chopstick *chopstick, unsigned int i);
+
+// chopstick_of:	Returns the left or right chopstick of the seat.
+t_chopstick	*chopstick_of(t_philo *philo, t_lock which);
+
+// first_lock:	Which of his chopsticks the seat takes first to respect the
+// 				hierarchy, the lower numbered one.
+t_lock	first_lock(t_philo *philo);
+
+// acquire_chopsticks:	Gets both chopsticks with the --strategy and reports
+// 						them. Returns 0 if the simulation stopped or an
+// 						error occured, else 1.
+int		acquire_chopsticks(t_philo *philo);
+
+// release_chopsticks:	Puts both chopsticks back with the --strategy.
+// 						Returns 0 in case of errors, else 1.
+int		release_chopsticks(t_philo *philo);
+
+// take_in_order:	--strategy=hierarchy, see strategy_order.c.
+int		take_in_order(t_philo *philo);
+
+// lock_chopstick:	Locks the left or right chopstick of the seat with the
+// 					--chopstick-lock, returns 0 on success like
+// 					pthread_mutex_lock.
+int		lock_chopstick(t_philo *philo, t_lock which);
+
+// unlock_chopstick:	Unlocks it, returns 0 on success like
+// 						pthread_mutex_unlock.
+int		unlock_chopstick(t_philo *philo, t_lock which);
+
+// unlock_chopsticks:	Unlocks both chopsticks of the seat. Returns 0 in
+// 						case of errors, else 1.
+int		unlock_chopsticks(t_philo *philo);
+
+// replay_turn:	With --replay, waits for the seat's turn at the chopstick.
+void	replay_turn(t_philo *philo, t_chopstick *chopstick, t_lock which);
+
+// record_grant:	Stamps the chopstick the seat just got, see grant_log.c.
+void	record_grant(t_philo *philo, t_chopstick *chopstick, t_lock which);
+
+// open_grant_log:	Sets up --record or --replay, loading the file of
+// 					--replay. Returns 0 if it cannot, else 1.
+int		open_grant_log(t_shared *info);
+
+// close_grant_log:	Writes the file of --record and frees the logs.
+void	close_grant_log(t_shared *info);
+
+// check_schedule:	Prints when the first philosopher would die if the plan
+// 					of --strategy=schedule does not feed everybody in
+// 					time. Returns 0 then, else 1.
+int		check_schedule(t_shared *info);
+
+// wait_slot:	--strategy=schedule, see strategy_schedule.c.
+int		wait_slot(t_philo *philo);
+
+// ask_waiter and thank_waiter:	--strategy=waiter, see strategy_waiter.c.
+int		ask_waiter(t_philo *philo);
+int		thank_waiter(t_philo *philo);
+
+// neighbour_of:	Returns the seat to the left or to the right of the seat.
+t_philo	*neighbour_of(t_philo *philo, t_lock which);
+
+// yields:	With --strategy=edf, whether a hungry neighbour who starves
+// 			earlier goes first. Called with the waiter mutex held.
+bool	yields(t_philo *philo);
+
+// serve_order:	The neighbours of the seat in the order the waiter serves
+// 				them, the one starving first first with edf.
+void	serve_order(t_philo *philo, t_philo **first, t_philo **second);
+
+// take_forks and put_forks:	--strategy=chandy-misra.
+int		take_forks(t_philo *philo);
+int		put_forks(t_philo *philo);
+
+// grant_seat:	Bumps the grant of a waiting seat and wakes it up.
+void	grant_seat(t_philo *philo);
+
+// wait_for_grant:	Blocks until the grant of the seat is not expected
+// 					anymore.
+void	wait_for_grant(t_philo *philo, int expected);
+
+// philo_sleeps:	A philosopher sleeps microseconds time, he is woken up
+// 					early if the simulation must stop. If the simulation
+// 					must stop or an error case occured it returns 0, else
+// 					it returns 1.
+int		philo_sleeps(t_philo *philo, time_t microseconds);
 
 // must_simulation_stop:	Returns true if the simulation must stop,
-//							it returns false.
+//							it returns false. It never takes a lock.
 bool	must_simulation_stop(t_philo *philo);
 
-//	report_philo_state:	Prints the state of a philosopher, which is
+// stop_simulation:	Stops the simulation for the given reason. Only the
+// 					first call wins, it returns true if it was this one.
+bool	stop_simulation(t_shared *info, t_stop reason);
+
+// sleep_until:	Blocks until the absolute deadline or until the simulation
+// 				stops. Returns 0 if it stopped, else 1.
+int		sleep_until(t_shared *info, time_t deadline);
+
+// wake_sleepers:	Wakes every thread blocked in sleep_until.
+void	wake_sleepers(t_shared *info);
+
+// wait_start_gate:	Blocks until the simulation starts.
+void	wait_start_gate(t_shared *info);
+
+// open_start_gate:	Stamps the start of the simulation and of every seat
+// 					with the current time, then lets every thread go.
+// 					Only the first call does anything.
+void	open_start_gate(t_shared *info);
+
+// futex_wait_until:	Blocks while the word holds expected, at most until
+// 						the absolute deadline.
+void	futex_wait_until(atomic_int *word, int expected, time_t deadline);
+
+// futex_wake:	Wakes up to count threads blocked on the word.
+void	futex_wake(atomic_int *word, int count);
+
+// parse_options:	Consumes the leading "--" options of the command line.
+// 					Returns false on an unknown option, else true.
+bool	parse_options(int *argc, char ***argv, t_options *opt);
+
+// parse_path:	Sets the option of arg that names a file or picks a mode, see
+//				options_path.c.
+bool	parse_path(t_options *opt, const char *arg);
+
+// record_meal:	Publishes last_meal_time and times_eaten of a philosopher
+// 				under his meal_seq. Only the philosopher himself calls it.
+void	record_meal(t_philo *philo, time_t meal_time, int times_eaten);
+
+// read_last_meal:	Returns a consistent snapshot of last_meal_time,
+// 					and stores times_eaten in the pointer if it is not NULL.
+time_t	read_last_meal(t_philo *philo, int *times_eaten);
+
+//	report_philo_state:	Reports the state of a philosopher, which is
 //						either eating, sleeping, thinking or when he
-//						grabs a chopstick. It returns 0 on error case,
-//						else returns 1.
-int		report_philo_state(t_philo *philo, const char *s);
+//						grabs a chopstick. It returns 0 if the simulation
+//						stopped, else returns 1.
+int		report_philo_state(t_philo *philo, t_state state);
+
+//	push_event:	Stamps an event with the time since the start and pushes
+//				it in the ring, unless the simulation stopped. Returns 0 if
+//				it was not pushed, else 1.
+int		push_event(t_ring *ring, t_shared *info, unsigned int id,
+			t_state state);
+
+//	trace_offset:	Where the records start in a trace file.
+size_t	trace_offset(unsigned int num_regions);
+
+//	open_trace:	With --trace, maps the trace file and gives every ring its
+//				region. Returns 0 if it fails, else 1.
+int		open_trace(t_shared *info);
+
+//	trace_event:	push_event with --trace, stores the event in the region
+//					of the ring. Returns 0 if the simulation stopped, else 1.
+int		trace_event(t_ring *ring, t_shared *info, unsigned int id,
+			t_state state);
+
+//	grow_region:	Chains another extent of the trace file to a full region.
+//					Returns 0 if the file cannot grow, else 1.
+int		grow_region(t_writer *writer, t_ring *ring);
+
+//	close_trace:	Writes the regions one after the other in a new trace
+//					file and closes the old one. Every producer must be
+//					done.
+void	close_trace(t_shared *info);
+
+//	open_stats_shm:	With --stats-shm, creates and maps the file the live
+//					stats are published in. Returns 0 if it fails, else 1.
+int		open_stats_shm(t_shared *info);
+
+//	ready_stats_shm:	Fills the header and the times of the seats, once
+//						the table is made, and tells readers it is ready.
+void	ready_stats_shm(t_shared *info);
+
+//	close_stats_shm:	Unmaps it, the file stays for the readers.
+void	close_stats_shm(t_shared *info);
+
+//	publish_meal:	Copies the meal record_meal just made to the seat of
+//					--stats-shm. Only the thread running the seat calls it.
+void	publish_meal(t_philo *philo, time_t meal_time, int times_eaten);
 
-//	unlock_mutex:	It takes the address of two mutexes and unlocks them.
-//					Returns 0 in cases of error, else 1.
-int		unlock_mutexes(pthread_mutex_t *mutex1, pthread_mutex_t *mutex2);
+//	publish_state:	Stores the state the seat reported in --stats-shm.
+void	publish_state(t_shared *info, unsigned int id, t_state state);
+
+//	publish_clock:	Stores now, in microseconds since the start, in
+//					--stats-shm.
+void	publish_clock(t_shared *info, time_t now);
+
+//	publish_full and publish_stop:	Store ate_max_meal and the reason the
+//									simulation stopped in --stats-shm.
+void	publish_full(t_shared *info);
+void	publish_stop(t_shared *info, t_stop reason);
+
+//	collect_events:	Moves the events of every ring to the pending events
+//					of the writer. Only the writer thread calls it.
+void	collect_events(t_writer *writer);
+
+//	init_writer:	Allocates the writer and the rings of the philosophers
+//					and the referee. Returns 0 if malloc fails, else 1.
+int		init_writer(t_shared *info);
+
+//	start_writer:	Creates the writer thread. Returns 0 if it fails, else 1.
+int		start_writer(t_shared *info);
+
+//	finish_writer:	Lets the writer print the last events, joins it, and
+//					frees everything init_writer allocated.
+void	finish_writer(t_shared *info);
+
+//	emit_events:	Prints the pending events in time order up to the
+//					watermark, or all of them until the last line when
+//					final is true, and writes the batch out.
+void	emit_events(t_writer *writer, time_t watermark, bool final);
+
+
+// think_time:	Returns how long a philosopher thinks after his sleep.
+time_t	think_time(t_philo *philo);
+
+// reset_think:	Clears the state of --think=adaptive of a seat.
+void	reset_think(t_philo *philo);
+
+// adaptive_think:	Returns the think time of --think=adaptive, see think.c.
+time_t	adaptive_think(t_philo *philo);
 
 // check_num_meals:	checks if the num_meals was specified or not.
 // 					Returns 0 in case of errors, and 1 if everything is fine.
 int		check_num_meals(t_philo *philo);
 
+// sift_down:	Moves the seat at pos of the monitor heap down to where its
+// 				deadline belongs.
+void	sift_down(t_philo **heap, unsigned int size, unsigned int pos);
+
+// update_deadline:	Moves the seat of the philosopher in the monitor heap
+// 					to its new deadline after a meal starting at meal_time.
+// 					Returns 0 in case of errors, else 1.
+int		update_deadline(t_philo *philo, time_t meal_time);
+
+// kick_referee:	Tells the referee that all philosophers are full.
+// 					Returns 0 in case of errors, else 1.
+int		kick_referee(t_shared *info);
+
+// pick_sweep:	Returns the sweep of the given kind, NULL if the CPU cannot
+// 				run it.
+t_sweep	pick_sweep(t_simd simd);
+
+// sweep_referee:	The referee of --monitor=sweep, see monitor_sweep.c.
+void	sweep_referee(t_shared *info);
+
+// wait_next_deadline:	Called by the referee with the monitor mutex
+// 						held, sleeps until the earliest deadline or
+// 						until a philosopher kicks him.
+// 						Returns 0 in case of errors, else 1.
+int		wait_next_deadline(t_shared *info);
+
+// start_pool:	Creates the workers of the pool and hands them the seats.
+// 				Returns 0 if anything fails, the simulation is stopped and
+// 				the workers already started are joined, else 1.
+int		start_pool(t_shared *info);
+
+// setup_pool:	Allocates the pool and places the seats without starting
+// 				any worker. Returns 0 if anything fails, else 1.
+int		setup_pool(t_shared *info);
+
+// join_pool:	Wakes up and joins every worker, then frees the pool.
+void	join_pool(t_shared *info);
+
+// free_pool:	Frees the pool and everything its workers allocated.
+void	free_pool(t_shared *info);
+
+// nudge_worker:	Wakes up a worker that sleeps in its idle wait.
+void	nudge_worker(t_worker *worker);
+
+// worker_routine:	The start routine of a worker of the pool.
+void	*worker_routine(void *arg);
+
+// push_ready:	Queues a seat the worker can run now. Returns 0 if malloc
+// 				fails, the simulation is stopped then, else 1.
+int		push_ready(t_worker *worker, t_philo *philo);
+
+// pop_ready:	Takes the next seat of the worker's own queue, NULL if empty.
+t_philo	*pop_ready(t_worker *worker);
+
+// steal_ready:	Takes a seat from the queue of another worker, NULL if
+// 				every queue is empty.
+t_philo	*steal_ready(t_worker *worker);
+
+// add_timer:	Resumes the seat at step when wake is reached. Returns 0 if
+// 				malloc fails, the simulation is stopped then, else 1.
+int		add_timer(t_worker *worker, t_philo *philo, t_step step,
+			time_t wake);
+
+// fire_timers:	Moves every seat whose wake is reached to the ready queue.
+void	fire_timers(t_worker *worker, time_t now);
+
+// run_seat:	Runs a seat of the pool until it has to wait for a timer or
+// 				a chopstick, or the simulation stops.
+void	run_seat(t_worker *worker, t_philo *philo);
+
+// take_chopstick:	Takes the chopstick for the seat if it is free and
+// 					returns 1, else the seat waits for it and 0 is
+// 					returned, it is queued again once handed the chopstick.
+int		take_chopstick(t_chopstick *chopstick, t_philo *philo);
+
+// put_chopstick:	Puts the chopstick down, or hands it to the seat waiting
+// 					for it. Returns 0 in case of errors, else 1.
+int		put_chopstick(t_worker *worker, t_chopstick *chopstick);
+
+// report_end:	Stops the simulation for reason and reports it as the last
+// 				line, philo is the one who starved when reason is PHILO_DIED.
+void	report_end(t_shared *info, t_philo *philo, t_stop reason);
+
+// run_virtual_time:	Runs the whole simulation on the virtual clock in the
+// 						calling thread, until it stops.
+void	run_virtual_time(t_shared *info);
+
+// run_batch:	Runs every table of the --batch file and prints a line for
+// 				each. Returns the exit status of the program.
+int		run_batch(t_options *opt);
+
+// runner_routine:	The start routine of a runner of --batch.
+void	*runner_routine(void *arg);
+
+// publish_result:	Marks the result of a table done and prints the results
+// 					that are done, in the order of the file.
+void	publish_result(t_batch *batch, t_result *result);
+
+/*
+ * The instrumentation is only compiled with PHILO_STATS (make STATS=1).
+ * Without it every STAT_ and STATS_ macro is the bare pthread call or
+ * nothing at all, so there is no cost whatsoever.
+ */
+# ifdef PHILO_STATS
+
+// stat_add:	Adds value to a counter of the seat's own buffer, only the
+// 			thread running the seat may call it.
+void	stat_add(atomic_long *counter, long value);
+
+// stat_max:	Same as stat_add, for a maximum.
+void	stat_max(atomic_long *counter, long value);
+
+// stat_lock:	Locks the mutex and counts the wait for it as the seat's.
+int		stat_lock(t_philo *philo, t_lock which, pthread_mutex_t *mutex);
+
+// stat_release:	Counts the time the seat held the lock, call it right
+// 					before unlocking.
+void	stat_release(t_philo *philo, t_lock which);
+
+// stat_unlock:	stat_release then unlocks the mutex, returns what
+// 				pthread_mutex_unlock returned.
+int		stat_unlock(t_philo *philo, t_lock which, pthread_mutex_t *mutex);
+
+// stat_sleep:	Counts how late the seat woke up after deadline.
+void	stat_sleep(t_philo *philo, time_t deadline);
+
+// stat_meal:	Counts the interval since the seat's previous meal.
+void	stat_meal(t_philo *philo, time_t meal_time);
+
+// init_stats:	Allocates the buffers and installs the SIGUSR1 handler.
+// 				Returns 0 if anything fails, else 1.
+int		init_stats(t_shared *info);
+
+// poll_stats:	Dumps the stats if SIGUSR1 was received since the last call.
+void	poll_stats(t_shared *info);
+
+// dump_stats:	Prints the summary table on stderr.
+void	dump_stats(t_shared *info);
+
+// free_stats:	Frees the buffers.
+void	free_stats(t_shared *info);
+
+#  define STAT_LOCK(philo, which, mutex) stat_lock(philo, which, mutex)
+#  define STAT_RELEASE(philo, which) stat_release(philo, which)
+#  define STAT_UNLOCK(philo, which, mutex) stat_unlock(philo, which, mutex)
+#  define STAT_SLEEP(philo, deadline) stat_sleep(philo, deadline)
+#  define STAT_MEAL(philo, meal_time) stat_meal(philo, meal_time)
+#  define STATS_INIT(info) init_stats(info)
+#  define STATS_POLL(info) poll_stats(info)
+#  define STATS_DUMP(info) dump_stats(info)
+#  define STATS_FREE(info) free_stats(info)
+# else
+#  define STAT_LOCK(philo, which, mutex) pthread_mutex_lock(mutex)
+#  define STAT_RELEASE(philo, which) (void)0
+#  define STAT_UNLOCK(philo, which, mutex) pthread_mutex_unlock(mutex)
+#  define STAT_SLEEP(philo, deadline) (void)0
+#  define STAT_MEAL(philo, meal_time) (void)0
+#  define STATS_INIT(info) 1
+#  define STATS_POLL(info) (void)0
+#  define STATS_DUMP(info) (void)0
+#  define STATS_FREE(info) (void)0
+# endif
+
 // referee:	This is the main thread, it simply monitors the simulation
 // 			and reports when a philosopher dies or if they have all
 // 			eaten the required number of meals.
@@ -0,0 +1,162 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool.c                                             :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:24:27 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:45:48 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Initializes the workers one by one, num_workers counts the ones whose
+ * lock is initialized. Each one reports into its own ring and starts with
+ * room for its share of the seats in its ready queue and its timer heap,
+ * both grow if more seats end up on it.
+ * Returns 0 if anything fails, else 1.
+ */
+static int	init_workers(t_shared *info, t_pool *pool)
+{
+	t_worker		*worker;
+	unsigned int	share;
+
+	share = info->num_philos / info->opt.workers + 1;
+	while (pool->num_workers < info->opt.workers)
+	{
+		worker = &pool->workers[pool->num_workers];
+		worker->info = info;
+		worker->ring = NULL;
+		if (info->writer)
+			worker->ring = &info->writer->rings[pool->num_workers];
+		worker->ready = malloc(sizeof(t_philo *) * share);
+		worker->timers = malloc(sizeof(t_philo *) * share);
+		worker->ready_cap = share;
+		worker->timers_cap = share;
+		atomic_init(&worker->nudge, 0);
+		atomic_init(&worker->idle, false);
+		if (!worker->ready || !worker->timers
+			|| pthread_mutex_init(&worker->lock, NULL))
+			return (0);
+		pool->num_workers++;
+	}
+	return (1);
+}
+
+/*
+ * Hands the seats out in contiguous slices, so the neighbours a seat
+ * shares its chopsticks with are mostly run by the same worker. As with
+ * a thread per philosopher, the even seats start 5ms late.
+ * Returns 0 if malloc fails, else 1.
+ */
+static int	place_seats(t_shared *info, t_pool *pool)
+{
+	t_worker		*worker;
+	t_philo			*philo;
+	unsigned int	i;
+	time_t			now;
+
+	now = sim_now(info);
+	i = 0;
+	while (i < info->num_philos)
+	{
+		philo = &info->table[i];
+		worker = &pool->workers[(size_t)i * pool->num_workers
+			/ info->num_philos];
+		philo->step = STEP_LEFT;
+		if (philo->philo_id % 2 == 0
+			&& !add_timer(worker, philo, STEP_LEFT, now + 5000))
+			return (0);
+		if (philo->philo_id % 2 != 0 && !push_ready(worker, philo))
+			return (0);
+		i++;
+	}
+	return (1);
+}
+
+/*
+ * Frees the pool, the ready queues and timer heaps of every worker, even
+ * the ones that failed to initialize, they were zeroed.
+ */
+void	free_pool(t_shared *info)
+{
+	t_pool			*pool;
+	unsigned int	i;
+
+	pool = info->pool;
+	i = 0;
+	while (pool->workers && i < info->opt.workers)
+	{
+		if (i < pool->num_workers)
+			pthread_mutex_destroy(&pool->workers[i].lock);
+		free(pool->workers[i].ready);
+		free(pool->workers[i++].timers);
+	}
+	free(pool->workers);
+	free(pool);
+	info->pool = NULL;
+}
+
+/*
+ * Allocates the pool and its workers, which are cache line aligned and
+ * zeroed, initializes them and places the seats. The seats are placed
+ * before any worker runs, so nothing else touches the queues yet.
+ * Returns 0 if anything fails, the pool is freed then, else 1.
+ */
+int	setup_pool(t_shared *info)
+{
+	t_pool	*pool;
+
+	pool = calloc(1, sizeof(t_pool));
+	if (!pool)
+	{
+		printf("Error: Malloc failed.\n");
+		return (0);
+	}
+	info->pool = pool;
+	if (posix_memalign((void **)&pool->workers, CACHE_LINE,
+			sizeof(t_worker) * info->opt.workers))
+		pool->workers = NULL;
+	if (pool->workers)
+		memset(pool->workers, 0, sizeof(t_worker) * info->opt.workers);
+	if (!pool->workers || !init_workers(info, pool)
+		|| !place_seats(info, pool))
+	{
+		printf("Error: Pool initialization failed.\n");
+		free_pool(info);
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * Sets the pool up and creates the workers. If creating a worker fails,
+ * the simulation is stopped and the ones already running are joined.
+ * Returns 0 if anything fails, else 1.
+ */
+int	start_pool(t_shared *info)
+{
+	t_worker	*worker;
+
+	if (!setup_pool(info))
+		return (0);
+	while (info->pool->num_started < info->pool->num_workers)
+	{
+		worker = &info->pool->workers[info->pool->num_started];
+		if (pthread_create(&worker->thread_id, NULL, worker_routine, worker))
+		{
+			printf("Error: pthread_create failed.\n");
+			stop_simulation(info, SIM_ERROR);
+			open_start_gate(info);
+			join_pool(info);
+			return (0);
+		}
+		pin_seat(info, worker->thread_id, info->pool->num_started,
+			info->pool->num_workers);
+		info->pool->num_started++;
+	}
+	return (1);
+}
@@ -0,0 +1,90 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_chopsticks.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:24:27 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:20:28 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * A worker must never block on a chopstick, it runs thousands of other
+ * seats. So in the pool a chopstick is not held by keeping its mutex
+ * locked for the meal, the mutex only guards taken and waiter for the
+ * moment it takes to look at them. Only the two philosophers next to a
+ * chopstick ever want it, so while it is taken there is at most one
+ * waiter. The step of the seat was set before, when it is handed the
+ * chopstick it resumes as if it had taken it itself.
+ * Returns 1 if the chopstick was taken, 0 if the seat waits for it or
+ * the lock failed.
+ */
+int	take_chopstick(t_chopstick *chopstick, t_philo *philo)
+{
+	bool	taken;
+
+	if (pthread_mutex_lock(&chopstick->mutex))
+	{
+		printf("Error: Chopstick mutex lock failed.\n");
+		stop_simulation(philo->info, SIM_ERROR);
+		return (0);
+	}
+	taken = chopstick->taken;
+	if (!taken)
+		chopstick->taken = true;
+	else
+		chopstick->waiter = philo;
+	pthread_mutex_unlock(&chopstick->mutex);
+	return (!taken);
+}
+
+/*
+ * Puts the chopstick down. If a neighbour waits for it, it stays taken
+ * and goes straight to him, his seat is queued on this worker, which is
+ * awake anyway, and other workers can steal it from there.
+ * Returns 0 in case of errors, else 1.
+ */
+int	put_chopstick(t_worker *worker, t_chopstick *chopstick)
+{
+	t_philo	*waiter;
+
+	if (pthread_mutex_lock(&chopstick->mutex))
+	{
+		printf("Error: Chopstick mutex lock failed.\n");
+		stop_simulation(worker->info, SIM_ERROR);
+		return (0);
+	}
+	waiter = chopstick->waiter;
+	chopstick->waiter = NULL;
+	chopstick->taken = (waiter != NULL);
+	pthread_mutex_unlock(&chopstick->mutex);
+	if (waiter)
+		return (push_ready(worker, waiter));
+	return (1);
+}
+
+/*
+ * It is assumed that every chopstick to the left of a philosopher's seat
+ * belongs to the philospher, it has the same index as his seat.
+ */
+t_chopstick	*l_chopstick(t_philo *philo)
+{
+	return (&philo->info->chopsticks[philo->philo_id - 1]);
+}
+
+/*
+ * The chopstick to the right of a philosopher is the one of the next
+ * seat, the first seat's for the last philosopher. If the number of
+ * philosphers is just 1, obviously he cannot eat, NULL is returned.
+ */
+t_chopstick	*r_chopstick(t_philo *philo)
+{
+	if (philo->info->num_philos == 1)
+		return (NULL);
+	return (&philo->info->chopsticks[philo->philo_id
+			% philo->info->num_philos]);
+}
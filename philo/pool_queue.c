@@ -0,0 +1,141 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_queue.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:24:27 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:24:27 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Doubles the ready queue of the worker, the seats are moved to the front
+ * of the new one in queue order. Called with the lock of the worker held.
+ * Returns 0 if malloc fails, else 1.
+ */
+static int	grow_ready(t_worker *worker)
+{
+	t_philo			**bigger;
+	unsigned int	i;
+
+	bigger = malloc(sizeof(t_philo *) * worker->ready_cap * 2);
+	if (!bigger)
+		return (0);
+	i = 0;
+	while (i < worker->ready_len)
+	{
+		bigger[i] = worker->ready[(worker->ready_head + i)
+			% worker->ready_cap];
+		i++;
+	}
+	free(worker->ready);
+	worker->ready = bigger;
+	worker->ready_head = 0;
+	worker->ready_cap *= 2;
+	return (1);
+}
+
+/*
+ * Wakes up one idle worker, if there is any, to steal some work.
+ */
+static void	wake_idle_worker(t_pool *pool)
+{
+	unsigned int	i;
+	bool			idle;
+
+	if (!atomic_load(&pool->num_idle))
+		return ;
+	i = 0;
+	while (i < pool->num_workers)
+	{
+		idle = true;
+		if (atomic_compare_exchange_strong(&pool->workers[i].idle,
+				&idle, false))
+		{
+			nudge_worker(&pool->workers[i]);
+			return ;
+		}
+		i++;
+	}
+}
+
+/*
+ * Queues a seat at the back of the ready queue of the worker. When the
+ * worker now has more than the seat it is about to run, another worker
+ * could take some, so an idle one is woken up.
+ */
+int	push_ready(t_worker *worker, t_philo *philo)
+{
+	unsigned int	len;
+
+	pthread_mutex_lock(&worker->lock);
+	if (worker->ready_len == worker->ready_cap && !grow_ready(worker))
+	{
+		pthread_mutex_unlock(&worker->lock);
+		printf("Error: Malloc failed.\n");
+		stop_simulation(worker->info, SIM_ERROR);
+		return (0);
+	}
+	worker->ready[(worker->ready_head + worker->ready_len++)
+		% worker->ready_cap] = philo;
+	len = worker->ready_len;
+	pthread_mutex_unlock(&worker->lock);
+	if (len > 1)
+		wake_idle_worker(worker->info->pool);
+	return (1);
+}
+
+/*
+ * The owner takes its seats from the front, in the order they became
+ * ready.
+ */
+t_philo	*pop_ready(t_worker *worker)
+{
+	t_philo	*philo;
+
+	philo = NULL;
+	pthread_mutex_lock(&worker->lock);
+	if (worker->ready_len)
+	{
+		philo = worker->ready[worker->ready_head];
+		worker->ready_head = (worker->ready_head + 1) % worker->ready_cap;
+		worker->ready_len--;
+	}
+	pthread_mutex_unlock(&worker->lock);
+	return (philo);
+}
+
+/*
+ * A thief looks at the other workers in turn, starting with the next
+ * one, and takes from the back of the first queue that is not empty, the
+ * end the owner gets to last.
+ */
+t_philo	*steal_ready(t_worker *worker)
+{
+	t_pool			*pool;
+	t_worker		*victim;
+	t_philo			*philo;
+	unsigned int	i;
+
+	pool = worker->info->pool;
+	i = 1;
+	while (i < pool->num_workers)
+	{
+		victim = &pool->workers[(worker - pool->workers + i)
+			% pool->num_workers];
+		pthread_mutex_lock(&victim->lock);
+		philo = NULL;
+		if (victim->ready_len)
+			philo = victim->ready[(victim->ready_head + --victim->ready_len)
+				% victim->ready_cap];
+		pthread_mutex_unlock(&victim->lock);
+		if (philo)
+			return (philo);
+		i++;
+	}
+	return (NULL);
+}
@@ -0,0 +1,120 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_seat.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:24:27 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:17:10 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The seat holds the left chopstick, which is reported now. Alone at the
+ * table there is no right one, the seat is left waiting until the referee
+ * finds him starved, like the thread of a lonely philosopher sleeping
+ * until he dies. Returns 1 if the seat can go on right away, else 0.
+ */
+static int	step_got_left(t_philo *philo)
+{
+	if (!report_philo_state(philo, FIRST_CHOPSTICK)
+		|| philo->info->num_philos == 1)
+		return (0);
+	philo->step = STEP_GOT_RIGHT;
+	return (take_chopstick(r_chopstick(philo), philo));
+}
+
+/*
+ * The seat holds both chopsticks, the meal is recorded exactly as in
+ * philo_eats, first in the monitor heap then in the seat itself, and the
+ * seat waits for the end of the meal on a timer.
+ */
+static int	step_got_right(t_worker *worker, t_philo *philo)
+{
+	time_t	meal_time;
+
+	if (!report_philo_state(philo, SECOND_CHOPSTICK))
+		return (0);
+	meal_time = sim_now(philo->info);
+	if (!update_deadline(philo, meal_time))
+		return (0);
+	record_meal(philo, meal_time, atomic_load_explicit(
+			&philo->times_eaten, memory_order_relaxed));
+	if (!report_philo_state(philo, EATING))
+		return (0);
+	add_timer(worker, philo, STEP_ATE,
+		sim_now(philo->info) + philo->profile->time_to_eat);
+	return (0);
+}
+
+/*
+ * The meal is over, the chopsticks are put down, right then left like
+ * the thread engine unlocks them, and handed to a neighbour waiting for
+ * them. Then the seat counts its meal and sleeps on a timer.
+ */
+static int	step_ate(t_worker *worker, t_philo *philo)
+{
+	if (!put_chopstick(worker, r_chopstick(philo))
+		|| !put_chopstick(worker, l_chopstick(philo))
+		|| !check_num_meals(philo))
+		return (0);
+	if (!report_philo_state(philo, SLEEPING))
+		return (0);
+	add_timer(worker, philo, STEP_SLEPT,
+		sim_now(philo->info) + philo->profile->time_to_sleep);
+	return (0);
+}
+
+/*
+ * The seat woke up and thinks for think_time, the same time a thread
+ * would. If that is no time at all, it goes for the chopsticks right away.
+ */
+static int	step_slept(t_worker *worker, t_philo *philo)
+{
+	time_t	time_to_think;
+
+	time_to_think = think_time(philo);
+	if (!report_philo_state(philo, THINKING))
+		return (0);
+	philo->step = STEP_LEFT;
+	if (!time_to_think)
+		return (1);
+	add_timer(worker, philo, STEP_LEFT,
+		sim_now(philo->info) + time_to_think);
+	return (0);
+}
+
+/*
+ * This is simulation, the loop of a philosopher thread, cut into steps.
+ * The seat reports into the ring of the worker that runs it, and goes
+ * from step to step until it waits for a timer or a chopstick, or the
+ * simulation stopped. A seat waiting for a chopstick may be queued on
+ * another worker as soon as it is handed one, so once a step returns 0
+ * the seat is not touched anymore, the next step was set before.
+ */
+void	run_seat(t_worker *worker, t_philo *philo)
+{
+	int	go_on;
+
+	philo->ring = worker->ring;
+	go_on = 1;
+	while (go_on)
+	{
+		if (philo->step == STEP_LEFT)
+		{
+			philo->step = STEP_GOT_LEFT;
+			go_on = take_chopstick(l_chopstick(philo), philo);
+		}
+		else if (philo->step == STEP_GOT_LEFT)
+			go_on = step_got_left(philo);
+		else if (philo->step == STEP_GOT_RIGHT)
+			go_on = step_got_right(worker, philo);
+		else if (philo->step == STEP_ATE)
+			go_on = step_ate(worker, philo);
+		else
+			go_on = step_slept(worker, philo);
+	}
+}
@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_timer.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:24:27 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:45:06 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Moves the seat at pos up the timer heap while it wakes earlier than
+ * its parent.
+ */
+static void	timer_sift_up(t_philo **heap, unsigned int pos)
+{
+	t_philo	*tmp;
+
+	while (pos && heap[(pos - 1) / 2]->wake > heap[pos]->wake)
+	{
+		tmp = heap[pos];
+		heap[pos] = heap[(pos - 1) / 2];
+		heap[(pos - 1) / 2] = tmp;
+		pos = (pos - 1) / 2;
+	}
+}
+
+/*
+ * Moves the root down the timer heap until both children wake later.
+ */
+static void	timer_sift_down(t_philo **heap, unsigned int size)
+{
+	unsigned int	pos;
+	unsigned int	child;
+	t_philo			*tmp;
+
+	pos = 0;
+	while (2 * pos + 1 < size)
+	{
+		child = 2 * pos + 1;
+		if (child + 1 < size && heap[child + 1]->wake < heap[child]->wake)
+			child++;
+		if (heap[pos]->wake <= heap[child]->wake)
+			break ;
+		tmp = heap[pos];
+		heap[pos] = heap[child];
+		heap[child] = tmp;
+		pos = child;
+	}
+}
+
+/*
+ * This is what philo_sleeps is in the pool: instead of blocking, the
+ * seat is parked in the timer heap of the worker until wake, then it
+ * resumes at step. The heap grows by doubling.
+ */
+int	add_timer(t_worker *worker, t_philo *philo, t_step step, time_t wake)
+{
+	t_philo	**bigger;
+
+	philo->step = step;
+	philo->wake = wake;
+	if (worker->num_timers == worker->timers_cap)
+	{
+		bigger = malloc(sizeof(t_philo *) * worker->timers_cap * 2);
+		if (!bigger)
+		{
+			printf("Error: Malloc failed.\n");
+			stop_simulation(worker->info, SIM_ERROR);
+			return (0);
+		}
+		memcpy(bigger, worker->timers, sizeof(t_philo *) * worker->num_timers);
+		free(worker->timers);
+		worker->timers = bigger;
+		worker->timers_cap *= 2;
+	}
+	worker->timers[worker->num_timers] = philo;
+	timer_sift_up(worker->timers, worker->num_timers++);
+	return (1);
+}
+
+/*
+ * Every seat whose wake is reached goes from the timer heap to the back
+ * of the ready queue, in the order they wake.
+ */
+void	fire_timers(t_worker *worker, time_t now)
+{
+	t_philo	*philo;
+
+	while (worker->num_timers && worker->timers[0]->wake <= now)
+	{
+		philo = worker->timers[0];
+		worker->timers[0] = worker->timers[--worker->num_timers];
+		timer_sift_down(worker->timers, worker->num_timers);
+		STAT_SLEEP(philo, philo->wake);
+		if (!push_ready(worker, philo))
+			return ;
+	}
+}
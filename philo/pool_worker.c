@@ -0,0 +1,99 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   pool_worker.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:24:27 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:45:48 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Bumps the futex word of the worker, so a worker that is just about to
+ * sleep sees it changed and does not, and wakes it if it already sleeps.
+ */
+void	nudge_worker(t_worker *worker)
+{
+	atomic_fetch_add(&worker->nudge, 1);
+	futex_wake(&worker->nudge, 1);
+}
+
+/*
+ * The worker has nothing to run. It raises idle first and looks for a
+ * seat to steal once more, so a busy worker that queued one in between
+ * either sees it idle and nudges it, or the seat is found here. Then it
+ * sleeps until its earliest timer, for a second at most, or until it is
+ * nudged. Returns the stolen seat, or NULL.
+ */
+static t_philo	*idle_worker(t_worker *worker)
+{
+	t_pool	*pool;
+	t_philo	*philo;
+	int		nudge;
+	time_t	until;
+
+	pool = worker->info->pool;
+	nudge = atomic_load(&worker->nudge);
+	atomic_store(&worker->idle, true);
+	atomic_fetch_add(&pool->num_idle, 1);
+	philo = steal_ready(worker);
+	until = get_time_us() + 1000000;
+	if (worker->num_timers && worker->timers[0]->wake < until)
+		until = worker->timers[0]->wake;
+	if (!philo && atomic_load(&worker->info->stop_epoch) == RUNNING)
+		futex_wait_until(&worker->nudge, nudge, until);
+	atomic_store(&worker->idle, false);
+	atomic_fetch_sub(&pool->num_idle, 1);
+	return (philo);
+}
+
+/*
+ * Once the start gate opens, a worker runs seats until the simulation
+ * stops. The seats whose timer fired come first into its queue, then it
+ * runs its own seats in order, and only when it has none it steals from
+ * the other workers, or sleeps.
+ * A seat runs until it waits for something, so a worker never blocks on
+ * a chopstick or sleeps for a philosopher.
+ */
+void	*worker_routine(void *arg)
+{
+	t_worker	*worker;
+	t_philo		*philo;
+
+	worker = (t_worker *)arg;
+	wait_start_gate(worker->info);
+	while (atomic_load_explicit(&worker->info->stop_epoch,
+			memory_order_acquire) == RUNNING)
+	{
+		fire_timers(worker, get_time_us());
+		philo = pop_ready(worker);
+		if (!philo)
+			philo = steal_ready(worker);
+		if (!philo)
+			philo = idle_worker(worker);
+		if (philo)
+			run_seat(worker, philo);
+	}
+	return (NULL);
+}
+
+/*
+ * Called once the simulation stopped. A worker may sleep until its next
+ * timer, so every one is woken up before it is joined.
+ */
+void	join_pool(t_shared *info)
+{
+	unsigned int	i;
+
+	i = 0;
+	while (i < info->pool->num_started)
+		nudge_worker(&info->pool->workers[i++]);
+	i = 0;
+	while (i < info->pool->num_started)
+		pthread_join(info->pool->workers[i++].thread_id, NULL);
+	free_pool(info);
+}
@@ -0,0 +1,102 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile.c                                          :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:17:09 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:24:01 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The numbers of the command line are the class of every seat the
+ * profile does not name, and of all of them without --profile.
+ */
+void	init_uniform(t_shared *info)
+{
+	info->uniform.time_to_die = info->time_to_die;
+	info->uniform.time_to_eat = info->time_to_eat;
+	info->uniform.time_to_sleep = info->time_to_sleep;
+	info->uniform.num_meals = info->num_meals;
+	info->uniform.line = 0;
+	info->uniform.first = 1;
+	info->uniform.last = info->num_philos;
+	info->uniform.step = 1;
+	info->profiles = &info->uniform;
+	info->num_profiles = 1;
+}
+
+/*
+ * The classes are applied in the order of the file, a seat named by
+ * several lines ends up in the last one. The first class is the copy of
+ * uniform in the array, it takes every seat first.
+ */
+static void	place_seats(t_shared *info)
+{
+	t_profile		*class;
+	unsigned int	k;
+	unsigned int	seat;
+
+	k = 0;
+	while (k < info->num_profiles)
+	{
+		class = &info->profiles[k++];
+		seat = class->first;
+		while (seat <= class->last)
+		{
+			info->table[seat - 1].profile = class;
+			seat += class->step;
+		}
+	}
+}
+
+/*
+ * The seats got their own time_to_die, so their deadlines differ, the
+ * monitor heap is built again bottom up, which is O(num_philos). The all
+ * full line tells the fewest meals a seat had to eat, there is none to
+ * tell if a seat has no target, they never all get full then.
+ */
+static void	settle_seats(t_shared *info)
+{
+	t_philo			*seat;
+	unsigned int	i;
+
+	i = 0;
+	while (i < info->num_philos)
+	{
+		seat = &info->table[i];
+		seat->deadline = info->sim_start_time + seat->profile->time_to_die;
+		if (info->monitor.deadlines)
+			atomic_init(&info->monitor.deadlines[i], seat->deadline);
+		if (!i || seat->profile->num_meals == -1 || (info->num_meals != -1
+				&& seat->profile->num_meals < info->num_meals))
+			info->num_meals = seat->profile->num_meals;
+		i++;
+	}
+	i = info->num_philos / 2;
+	while (i-- > 0)
+		sift_down(info->monitor.heap, info->num_philos, i);
+}
+
+/*
+ * --profile: the seats are in the class of the command line until the
+ * file moves them, the five numbers are the uniform case of a profile.
+ * The table is made, the threads are not, so the seats are written
+ * without any lock. Returns 0 if the file is not valid, else 1.
+ */
+int	load_profile(t_shared *info)
+{
+	if (!info->opt.profile)
+		return (1);
+	if (!read_profile(info, info->opt.profile))
+		return (0);
+	place_seats(info);
+	settle_seats(info);
+	if (info->writer)
+		info->writer->num_meals = info->num_meals;
+	return (1);
+}
@@ -0,0 +1,163 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile_parse.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:17:09 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:30:12 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Reads a number of at most 9 digits after any blanks, in milliseconds
+ * with up to three decimals when ms is true, microseconds go in value
+ * then. Returns what follows the number, NULL if there is none.
+ */
+static char	*read_number(char *s, long *value, bool ms)
+{
+	long	scale;
+	int		digits;
+
+	s += strspn(s, " \t");
+	*value = 0;
+	digits = 0;
+	while (*s >= '0' && *s <= '9' && digits++ < 9)
+		*value = *value * 10 + (*s++ - '0');
+	if (!digits || (*s >= '0' && *s <= '9'))
+		return (NULL);
+	if (!ms)
+		return (s);
+	*value *= 1000;
+	scale = 100;
+	if (*s == '.')
+		s++;
+	while (scale && *s >= '0' && *s <= '9')
+	{
+		*value += (*s++ - '0') * scale;
+		scale /= 10;
+	}
+	return (s);
+}
+
+/*
+ * The seats of a line are "first", "first-last" or "first-last/step".
+ * Returns what follows them, NULL if they are not valid.
+ */
+static char	*read_seats(char *s, t_profile *class)
+{
+	long	seats[3];
+
+	s = read_number(s, &seats[0], false);
+	seats[1] = seats[0];
+	seats[2] = 1;
+	if (s && *s == '-')
+		s = read_number(s + 1, &seats[1], false);
+	if (s && *s == '/')
+		s = read_number(s + 1, &seats[2], false);
+	if (!s || seats[0] < 1 || seats[1] < seats[0] || seats[2] < 1)
+		return (NULL);
+	class->first = seats[0];
+	class->last = seats[1];
+	class->step = seats[2];
+	return (s);
+}
+
+/*
+ * A line is "seats time_to_die time_to_eat time_to_sleep [meals]", the
+ * times in milliseconds like on the command line, and like there a meal
+ * target of 0 is not valid. Without one, num_meals is left at -1 for
+ * add_class. Returns false if the line is not valid.
+ */
+static bool	parse_line(char *s, t_profile *class)
+{
+	long	meals;
+
+	s = read_seats(s, class);
+	if (s)
+		s = read_number(s, &class->time_to_die, true);
+	if (s)
+		s = read_number(s, &class->time_to_eat, true);
+	if (s)
+		s = read_number(s, &class->time_to_sleep, true);
+	class->num_meals = -1;
+	if (s && s[strspn(s, " \t\n")])
+	{
+		s = read_number(s, &meals, false);
+		class->num_meals = meals;
+		if (!meals)
+			return (false);
+	}
+	return (s && !s[strspn(s, " \t\n")]);
+}
+
+/*
+ * Appends the class of the line to the profiles, the seats of the line
+ * must be at the table. A line without meals keeps the target of the
+ * command line, none if it has none. The array doubles whenever its size
+ * is a power of two, the first one being the uniform class in the shared
+ * info.
+ * Returns 0 if the line is not valid or malloc fails, else 1.
+ */
+static int	add_class(t_shared *info, char *line, t_profile *class)
+{
+	t_profile	*bigger;
+
+	if (!parse_line(line, class) || class->last > info->num_philos)
+	{
+		printf("Error: Invalid profile line %u.\n", class->line);
+		return (0);
+	}
+	if (class->num_meals == -1)
+		class->num_meals = info->num_meals;
+	if (!(info->num_profiles & (info->num_profiles - 1)))
+	{
+		bigger = malloc(sizeof(t_profile) * info->num_profiles * 2);
+		if (!bigger)
+			return (0);
+		memcpy(bigger, info->profiles, sizeof(t_profile) * info->num_profiles);
+		if (info->profiles != &info->uniform)
+			free(info->profiles);
+		info->profiles = bigger;
+	}
+	info->profiles[info->num_profiles++] = *class;
+	return (1);
+}
+
+/*
+ * Every line of the file is a class, empty lines and lines starting with
+ * '#' are skipped. Stops at the first line that is not valid and tells
+ * which one.
+ * Returns 0 if the file cannot be read or is not valid, else 1.
+ */
+int	read_profile(t_shared *info, const char *path)
+{
+	FILE			*file;
+	char			*line;
+	size_t			size;
+	t_profile		class;
+	int				ok;
+
+	file = fopen(path, "r");
+	if (!file)
+	{
+		printf("Error: Cannot read the profile %s.\n", path);
+		return (0);
+	}
+	line = NULL;
+	size = 0;
+	class.line = 0;
+	ok = 1;
+	while (ok && getline(&line, &size, file) > 0)
+	{
+		class.line++;
+		if (line[strspn(line, " \t\n")] && line[strspn(line, " \t")] != '#')
+			ok = add_class(info, line, &class);
+	}
+	free(line);
+	fclose(file);
+	return (ok);
+}
@@ -0,0 +1,73 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   profile_print.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:17:09 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:30:19 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Counts the seats of every class and the meals they ate. The profile of
+ * a seat is one of the profiles, const only for the seat.
+ */
+static void	count_classes(t_shared *info)
+{
+	t_profile		*class;
+	unsigned int	i;
+
+	i = 0;
+	while (i < info->num_profiles)
+	{
+		info->profiles[i].seats = 0;
+		info->profiles[i++].meals = 0;
+	}
+	i = 0;
+	while (i < info->num_philos)
+	{
+		class = (t_profile *)info->table[i].profile;
+		class->seats++;
+		class->meals += atomic_load_explicit(&info->table[i++].times_eaten,
+				memory_order_relaxed);
+	}
+}
+
+/*
+ * With --profile, prints the throughput of every class on stderr, so it
+ * never mixes with the events on stdout: its line in the file, 0 for
+ * the numbers of the command line, its seats, times in milliseconds and
+ * meal target, the meals its seats ate, and the meals per second of the
+ * class and of one of its seats, over the whole simulation. A class whose
+ * seats all went to later lines is left out.
+ */
+void	print_profile(t_shared *info)
+{
+	t_profile		*class;
+	unsigned int	i;
+	double			secs;
+
+	if (!info->opt.profile || !info->table)
+		return ;
+	count_classes(info);
+	secs = (sim_now(info) - info->sim_start_time) / 1e6;
+	fprintf(stderr, "%-5s %7s %8s %8s %8s %6s %10s %10s %10s\n", "line",
+		"seats", "die ms", "eat ms", "sleep ms", "meals", "eaten",
+		"meals/s", "per seat");
+	i = 0;
+	while (i < info->num_profiles)
+	{
+		class = &info->profiles[i++];
+		if (!class->seats)
+			continue ;
+		fprintf(stderr, "%-5u %7u %8.3f %8.3f %8.3f %6d %10ld %10.1f %10.2f\n",
+			class->line, class->seats, class->time_to_die / 1e3,
+			class->time_to_eat / 1e3, class->time_to_sleep / 1e3,
+			class->num_meals, class->meals, class->meals / secs,
+			class->meals / secs / class->seats);
+	}
+}
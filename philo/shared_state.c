@@ -0,0 +1,108 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   shared_state.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 00:54:24 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:41:22 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Stops the simulation for the given reason. The stop_epoch is only
+ * changed from RUNNING, so the first reason (a death, all philosophers
+ * full or an error) is the one that sticks, and every sleeping
+ * philosopher is woken up to see it. --stats-shm is told too.
+ * Returns true if this call
+ * stopped the simulation, else false.
+ */
+bool	stop_simulation(t_shared *info, t_stop reason)
+{
+	int	expected;
+
+	expected = RUNNING;
+	if (!atomic_compare_exchange_strong(&info->stop_epoch,
+			&expected, reason))
+		return (false);
+	publish_stop(info, reason);
+	wake_sleepers(info);
+	return (true);
+}
+
+/*
+ * Checks if the simulation needs to stop or not. The stop_epoch is a single
+ * atomic, so this is a plain load, no mutex is taken. Returns true if
+ * simulation must stop, else returns false.
+ */
+bool	must_simulation_stop(t_philo *philo)
+{
+	return (atomic_load_explicit(&philo->info->stop_epoch,
+			memory_order_acquire) != RUNNING);
+}
+
+/*
+ * The clock of the simulation. It is CLOCK_MONOTONIC, except with
+ * --virtual-time, where it is the virtual clock the single thread
+ * running the simulation moves from one event to the next.
+ */
+time_t	sim_now(t_shared *info)
+{
+	if (info->opt.virtual_time)
+		return (info->virtual_now);
+	return (get_time_us());
+}
+
+/*
+ * The writer side of the meal_seq sequence lock. The sequence is made odd
+ * before the fields are written and even again after, the release order
+ * makes sure a reader that sees the same even sequence twice has read
+ * both fields from the same meal. --stats-shm gets a copy.
+ */
+void	record_meal(t_philo *philo, time_t meal_time, int times_eaten)
+{
+	unsigned int	seq;
+
+	seq = atomic_load_explicit(&philo->meal_seq, memory_order_relaxed);
+	atomic_store_explicit(&philo->meal_seq, seq + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&philo->last_meal_time, meal_time,
+		memory_order_relaxed);
+	atomic_store_explicit(&philo->times_eaten, times_eaten,
+		memory_order_relaxed);
+	atomic_store_explicit(&philo->meal_seq, seq + 2, memory_order_release);
+	publish_meal(philo, meal_time, times_eaten);
+}
+
+/*
+ * The reader side of the meal_seq sequence lock. It retries while the
+ * philosopher is in the middle of a write, the philosopher is never
+ * blocked by the reader.
+ */
+time_t	read_last_meal(t_philo *philo, int *times_eaten)
+{
+	unsigned int	seq;
+	time_t			meal_time;
+	int				eaten;
+
+	while (true)
+	{
+		seq = atomic_load_explicit(&philo->meal_seq, memory_order_acquire);
+		if (seq % 2 != 0)
+			continue ;
+		meal_time = atomic_load_explicit(&philo->last_meal_time,
+				memory_order_relaxed);
+		eaten = atomic_load_explicit(&philo->times_eaten,
+				memory_order_relaxed);
+		atomic_thread_fence(memory_order_acquire);
+		if (atomic_load_explicit(&philo->meal_seq,
+				memory_order_relaxed) == seq)
+			break ;
+	}
+	if (times_eaten)
+		*times_eaten = eaten;
+	return (meal_time);
+}
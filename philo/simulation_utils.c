@@ -6,151 +6,125 @@
 /*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
 /*                                                +#+#+#+#+#+   +#+           */
 /*   Created: 2025/01/04 16:16:00 by sudaniel          #+#    #+#             */
-/*   Updated: 2025/01/08 06:37:27 by sudaniel         ###   ########.fr       */
+/*   Updated: 2026/10/18 04:02:19 by sudaniel         ###   ########.fr       */
 /*                                                                            */
 /* ************************************************************************** */
 
 #include "philo.h"
 
 /*
- * checks if the number of meals was specified, if it was,
- * it increments times eaten for the philo, and checks if the philo
- * has eaten at least the amount of num_meals specified, if true,
- * increments ate_max_meal. It returns 1 if num_meals was not specified,
- * or if it was specified and no error case occured, in case of errors
- * 0 is returned.
+ * increments times eaten for the philo, --batch counts the meals of a
+ * table with it. If the number of meals was specified, it checks if the
+ * philo has eaten exactly the amount of num_meals specified, only then
+ * ate_max_meal is incremented, a single atomic add, every other meal only
+ * touches the philo's own seat. No lock is taken here. It returns 1 if
+ * num_meals was not specified, or if it was specified and no error case
+ * occured, in case of errors 0 is returned. The philosopher whose add
+ * makes everyone full kicks the referee awake, exactly one of them sees
+ * num_philos.
  */
 int	check_num_meals(t_philo *philo)
 {
-	if (philo->info->num_meals != -1)
-	{
-		philo->times_eaten++;
-		if (pthread_mutex_lock(&philo->info->args_mutex))
-		{
-			printf("\nError: Mutex lock failed.\n");
-			return (0);
-		}
-		if (philo->times_eaten == philo->info->num_meals)
-			philo->info->ate_max_meal++;
-		if (pthread_mutex_unlock(&philo->info->args_mutex))
-		{
-			printf("\nError: Mutex unlock failed.\n");
-			return (0);
-		}
-	}
-	return (1);
-}
+	int				times_eaten;
+	unsigned int	full;
 
-/*
- * A custom function that unlocks mutexes. Returns 0 in cases of an error,
- * else returns 1.
- */
-int	unlock_mutexes(pthread_mutex_t *mutex1, pthread_mutex_t *mutex2)
-{
-	if (mutex1)
-	{
-		if (pthread_mutex_unlock(mutex1))
-		{
-			printf("\nError: Mutex unlock failed.\n");
-			return (0);
-		}
-	}
-	if (mutex2)
-	{
-		if (pthread_mutex_unlock(mutex2))
-		{
-			printf("\nError: Mutex unlock failed.\n");
-			return (0);
-		}
-	}
+	times_eaten = atomic_load_explicit(&philo->times_eaten,
+			memory_order_relaxed) + 1;
+	record_meal(philo, atomic_load_explicit(&philo->last_meal_time,
+			memory_order_relaxed), times_eaten);
+	if (times_eaten != philo->profile->num_meals)
+		return (1);
+	full = atomic_fetch_add_explicit(&philo->info->ate_max_meal, 1,
+			memory_order_relaxed) + 1;
+	publish_full(philo->info);
+	if (full == philo->info->num_philos)
+		return (kick_referee(philo->info));
 	return (1);
 }
 
 /*
- * Checks if the simulation needs to stop or not, it locks the args mutex,
- * and checks if any philosopher is dead or if they have all eaten
- * at least the number of meals specified. Returns true if simulation
- * must stop, else returns false.
+ * time_to_think, is used to regulate how much time a philosopher
+ * thinks. This is important for
+ * synchronization, because if a philospher can spare some
+ * time to think and not starve, then that allows the other, the time
+ * to grab the chopsticks and eat. It is calculated by dividing
+ * the result of subtracting the time that has elapsed since the last meal
+ * of a philosopher (this is roughly the sum of time_to_eat + time_to_sleep)
+ * from the time_to_die.
+ * If this time is less than or equal 10, he thinks for 0ms, if this
+ * time is greater than or equal to 200, he thinks for 100ms else
+ * he thinks for the calculated time.
+ * why is it divided by 2? A philosopher is blocked, if he cannot lock
+ * a mutex, this is managed by the operating system, therefore, it
+ * is not known how long he is blocked for, to account for this possibility
+ * it is divided by 2.
+ * Both engines use it, so they think for the same time.
+ * --think=adaptive replaces all of it, see think.c. The seats of
+ * --strategy=schedule do not think for a time, but until their slot.
  */
-bool	must_simulation_stop(t_philo *philo)
+time_t	think_time(t_philo *philo)
 {
-	if (pthread_mutex_lock(&philo->info->args_mutex))
-	{
-		printf("\nError: Mutex lock failed.\n");
-		return (true);
-	}
-	if (philo->info->is_philo_dead)
-	{
-		pthread_mutex_unlock(&philo->info->args_mutex);
-		return (true);
-	}
-	if (philo->info->have_all_philos_eaten_max_meal)
-	{
-		pthread_mutex_unlock(&philo->info->args_mutex);
-		return (true);
-	}
-	if (pthread_mutex_unlock(&philo->info->args_mutex))
-	{
-		printf("\nError: Mutex unlock failed.\n");
-		return (true);
-	}
-	return (false);
+	time_t	time_to_think;
+
+	if (philo->info->opt.strategy == STRATEGY_SCHEDULE)
+		return (0);
+	if (philo->info->opt.think == THINK_ADAPTIVE)
+		return (adaptive_think(philo));
+	time_to_think = (philo->profile->time_to_die - (sim_now(philo->info)
+				- atomic_load_explicit(&philo->last_meal_time,
+					memory_order_relaxed))) / 2;
+	if (time_to_think >= 200000)
+		time_to_think = 100000;
+	else if (time_to_think <= 10000)
+		time_to_think = 0;
+	return (time_to_think);
 }
 
 /*
- * Puts the philo to sleep for milliseconds time, the philosopher wakes
- * regularly to check if the simulation must end. In error cases or if 
- * the simulation must end, 0 is returned else 1 is returned.
+ * The --poll-sleep way of sleeping: the philosopher wakes every 250us to
+ * check if the simulation must end. While the cheap coarse clock says the
+ * end is more than its resolution away, the precise clock is not even
+ * read. Returns 0 if the simulation must end, else 1.
  */
-int	philo_sleeps(t_philo *philo, time_t milliseconds)
+static int	poll_sleep(t_philo *philo, time_t wake_up_alarm)
 {
-	time_t	wake_up_alarm;
-	time_t	start_sleep_alarm;
-
-	start_sleep_alarm = get_time_ms();
-	if (!start_sleep_alarm)
-	{
-		printf("\nError: get_time_ms failed in philo_sleeps.\n");
-		return (0);
-	}
 	while (true)
 	{
 		usleep(250);
 		if (must_simulation_stop(philo))
 			return (0);
-		wake_up_alarm = get_time_ms() - start_sleep_alarm;
-		if (wake_up_alarm < 0)
-		{
-			printf("\nError: get_time_ms failed in philo_sleeps.\n");
-			return (0);
-		}
-		if (wake_up_alarm >= milliseconds)
+		if (get_coarse_time_us() + philo->info->coarse_slack < wake_up_alarm)
+			continue ;
+		if (get_time_us() >= wake_up_alarm)
 			break ;
 	}
 	return (1);
 }
 
 /*
- * Reports what the philospher is doing at a specific time, it locks the
- * mutex to that, this is to prevent possible interleaving of printings.
- * it returns 0 in cases of errors else, 1.
- * Most pthread fuctions return 0 on success and non zero int on failure,
- * this is why almost all call of pthread functions are tested for
- * errors.
+ * Puts the philo to sleep for microseconds time. The end of the sleep is
+ * an absolute time, the philosopher blocks until then and is woken up
+ * right away if the simulation stops meanwhile, so a sleeping
+ * philosopher costs no CPU at all. In error cases or if the simulation
+ * must end, 0 is returned else 1 is returned.
  */
-int	report_philo_state(t_philo *philo, const char *s)
+int	philo_sleeps(t_philo *philo, time_t microseconds)
 {
-	if (pthread_mutex_lock(&philo->info->args_mutex))
-	{
-		printf("\nError: Mutex lock failed.\n");
-		return (0);
-	}
-	printf("%lu %d %s\n", get_time_ms() - philo->info->sim_start_time,
-		philo->philo_id, s);
-	if (pthread_mutex_unlock(&philo->info->args_mutex))
+	time_t	wake_up_alarm;
+	int		ret;
+
+	wake_up_alarm = get_time_us();
+	if (!wake_up_alarm)
 	{
-		printf("\nError: Mutex unlock failed.\n");
+		printf("\nError: get_time_us failed in philo_sleeps.\n");
 		return (0);
 	}
-	return (1);
+	wake_up_alarm += microseconds;
+	if (philo->info->opt.poll_sleep)
+		ret = poll_sleep(philo, wake_up_alarm);
+	else
+		ret = sleep_until(philo->info, wake_up_alarm);
+	if (ret)
+		STAT_SLEEP(philo, wake_up_alarm);
+	return (ret);
 }
@@ -0,0 +1,160 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   spawn.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:45:34 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:46:37 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Every philosopher thread gets a stack of --stack-size, STACK_SIZE by
+ * default instead of the 8MB of the system. A philosopher never goes
+ * deep, what matters at tens of thousands of seats is the address space
+ * and the page tables the stacks take.
+ * Returns 0 if the size is refused, else 1.
+ */
+static int	init_attr(pthread_attr_t *attr, t_shared *info)
+{
+	size_t	size;
+
+	size = info->opt.stack_size;
+	if (!size)
+		size = STACK_SIZE;
+	if (pthread_attr_init(attr))
+		return (0);
+	if (pthread_attr_setstacksize(attr, size))
+	{
+		pthread_attr_destroy(attr);
+		printf("Error: Invalid stack size.\n");
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * Creates the philosophers of the slice one after the other, they wait
+ * at the start gate, so nobody starts before the whole table exists.
+ * Stops at the first thread that cannot be made.
+ */
+static void	*spawn_slice(void *arg)
+{
+	t_spawner	*spawner;
+	t_philo		*philo;
+
+	spawner = (t_spawner *)arg;
+	while (spawner->first + spawner->created < spawner->end)
+	{
+		philo = &spawner->table[spawner->first + spawner->created];
+		if (pthread_create(&philo->thread_id, spawner->attr, philo_routine,
+				philo))
+		{
+			printf("Error: pthread_create failed.\n");
+			spawner->failed = true;
+			return (NULL);
+		}
+		pin_seat(spawner->table->info, philo->thread_id,
+			spawner->first + spawner->created, philo->info->num_philos);
+		spawner->created++;
+	}
+	return (NULL);
+}
+
+/*
+ * With --spawners=N the table is cut into N slices that are created in
+ * parallel, a spawner thread each, the calling thread does the slice of
+ * a spawner it could not create. Returns false if any slice failed.
+ */
+static bool	run_spawners(t_philo *table, pthread_attr_t *attr,
+		t_spawner *spawners, unsigned int count)
+{
+	unsigned int	i;
+	bool			failed;
+
+	i = 0;
+	while (i < count)
+	{
+		spawners[i].table = table;
+		spawners[i].attr = attr;
+		spawners[i].first = (size_t)i * table->info->num_philos / count;
+		spawners[i].end = (size_t)(i + 1) * table->info->num_philos / count;
+		spawners[i].started = (count > 1 && !pthread_create(
+					&spawners[i].thread_id, attr, spawn_slice, &spawners[i]));
+		if (!spawners[i].started)
+			spawn_slice(&spawners[i]);
+		i++;
+	}
+	failed = false;
+	while (i-- > 0)
+	{
+		if (spawners[i].started)
+			pthread_join(spawners[i].thread_id, NULL);
+		failed = (failed || spawners[i].failed);
+	}
+	return (!failed);
+}
+
+/*
+ * A thread could not be made, the ones that were are waiting at the
+ * start gate. The simulation is stopped before the gate opens, so they
+ * leave right away, and they are joined.
+ */
+static void	join_created(t_shared *info, t_spawner *spawners,
+		unsigned int count)
+{
+	unsigned int	i;
+	unsigned int	j;
+
+	stop_simulation(info, SIM_ERROR);
+	open_start_gate(info);
+	i = 0;
+	while (i < count)
+	{
+		j = 0;
+		while (j < spawners[i].created)
+			pthread_join(spawners[i].table[spawners[i].first + j++].thread_id,
+				NULL);
+		i++;
+	}
+}
+
+/*
+ * For every seat at the table, a thread (philosopher) is created
+ * and assigned philo_routine as its starting routine, the seat is passed
+ * as argument to it. The threads wait at the start gate, which the
+ * referee opens once they all exist.
+ * If thread creation fails, the threads already made are stopped and
+ * joined and 0 is returned, else, 1 is returned.
+ */
+int	create_philos(t_philo *table)
+{
+	t_spawner		*spawners;
+	pthread_attr_t	attr;
+	unsigned int	count;
+	bool			created;
+
+	count = table->info->opt.spawners;
+	if (count > table->info->num_philos)
+		count = table->info->num_philos;
+	if (!count)
+		count = 1;
+	spawners = calloc(count, sizeof(t_spawner));
+	if (!spawners)
+		printf("Error: Malloc failed.\n");
+	if (!spawners || !init_attr(&attr, table->info))
+	{
+		free(spawners);
+		return (0);
+	}
+	created = run_spawners(table, &attr, spawners, count);
+	if (!created)
+		join_created(table->info, spawners, count);
+	pthread_attr_destroy(&attr);
+	free(spawners);
+	return (created);
+}
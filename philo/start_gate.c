@@ -0,0 +1,83 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   start_gate.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:45:34 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:17:10 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The threads made before the start wait here, the philosophers, the
+ * workers of the pool and the writer. A wakeup for any other reason
+ * simply waits again.
+ */
+void	wait_start_gate(t_shared *info)
+{
+	while (!atomic_load_explicit(&info->start_gate, memory_order_acquire))
+		futex_wait_until(&info->start_gate, 0, get_time_us() + 1000000);
+}
+
+/*
+ * The timers of the pool were set before the start moved, they move
+ * with it, which keeps every timer heap in order.
+ */
+static void	shift_timers(t_shared *info, time_t shift)
+{
+	t_worker		*worker;
+	unsigned int	i;
+	unsigned int	j;
+
+	i = 0;
+	while (info->pool && i < info->pool->num_workers)
+	{
+		worker = &info->pool->workers[i++];
+		j = 0;
+		while (j < worker->num_timers)
+			worker->timers[j++]->wake += shift;
+	}
+}
+
+/*
+ * sim_start_time was taken before the table was made and the threads
+ * created, at tens of thousands of seats the first philosophers would
+ * have been starving long before the last ones exist. Every thread waits
+ * at the gate instead, and the start of the simulation, the last meal
+ * and the deadline of every seat are all stamped with the one instant
+ * the gate opens, nobody runs meanwhile, and the release store hands all
+ * of it to them. Every deadline moves by the same shift, the monitor heap
+ * stays in order, also with the times of --profile.
+ */
+void	open_start_gate(t_shared *info)
+{
+	time_t			now;
+	unsigned int	i;
+	t_philo			*seat;
+
+	if (atomic_load(&info->start_gate))
+		return ;
+	now = get_time_us();
+	info->startup = now - info->startup;
+	shift_timers(info, now - info->sim_start_time);
+	info->sim_start_time = now;
+	info->virtual_now = now;
+	i = 0;
+	while (i < info->num_philos)
+	{
+		seat = &info->table[i];
+		atomic_store_explicit(&seat->last_meal_time, now,
+			memory_order_relaxed);
+		seat->deadline = now + seat->profile->time_to_die;
+		if (info->monitor.deadlines)
+			atomic_store_explicit(&info->monitor.deadlines[i],
+				seat->deadline, memory_order_relaxed);
+		i++;
+	}
+	atomic_store_explicit(&info->start_gate, 1, memory_order_release);
+	futex_wake(&info->start_gate, INT_MAX);
+}
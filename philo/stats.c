@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:45:06 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:45:06 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef PHILO_STATS
+
+static atomic_int	g_dump_requested;
+
+/*
+ * A signal handler may not print, it only asks the writer thread to dump
+ * the stats the next time it wakes up. The handler runs on any thread,
+ * so the flag is a lock-free atomic rather than a sig_atomic_t.
+ */
+static void	on_sigusr1(int signum)
+{
+	(void)signum;
+	atomic_store(&g_dump_requested, 1);
+}
+
+/*
+ * One buffer per seat, each starting on its own cache line so that two
+ * seats never write the same line. kill -USR1 dumps them while the
+ * simulation runs.
+ * Returns 0 if anything fails, else 1.
+ */
+int	init_stats(t_shared *info)
+{
+	struct sigaction	action;
+
+	if (posix_memalign((void **)&info->stats, CACHE_LINE,
+			sizeof(t_seat_stats) * info->num_philos))
+	{
+		info->stats = NULL;
+		printf("Error: Malloc failed.\n");
+		return (0);
+	}
+	memset(info->stats, 0, sizeof(t_seat_stats) * info->num_philos);
+	memset(&action, 0, sizeof(struct sigaction));
+	action.sa_handler = on_sigusr1;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	if (sigaction(SIGUSR1, &action, NULL))
+	{
+		printf("Error: sigaction failed.\n");
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * Called by the writer thread every millisecond.
+ */
+void	poll_stats(t_shared *info)
+{
+	if (atomic_exchange(&g_dump_requested, 0))
+		dump_stats(info);
+}
+
+/*
+ * Frees the buffers.
+ */
+void	free_stats(t_shared *info)
+{
+	free(info->stats);
+	info->stats = NULL;
+}
+
+#endif
@@ -0,0 +1,134 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_dump.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:45:06 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:08:47 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef PHILO_STATS
+
+/*
+ * A relaxed read of a counter, the seats may still be writing them.
+ */
+static long	get(atomic_long *counter)
+{
+	return (atomic_load_explicit(counter, memory_order_relaxed));
+}
+
+/*
+ * Sums the lock over every seat: how often it was taken, the average and
+ * worst wait and which seat waited that long, and the average hold.
+ */
+static void	print_lock(t_shared *info, t_lock which, const char *name)
+{
+	t_lock_stats	*lock;
+	long			sums[3];
+	long			max;
+	unsigned int	worst;
+	unsigned int	i;
+
+	memset(sums, 0, sizeof(sums));
+	max = -1;
+	worst = 0;
+	i = 0;
+	while (i < info->num_philos)
+	{
+		lock = &info->stats[i++].locks[which];
+		sums[0] += get(&lock->count);
+		sums[1] += get(&lock->wait);
+		sums[2] += get(&lock->hold);
+		if (get(&lock->max_wait) <= max)
+			continue ;
+		max = get(&lock->max_wait);
+		worst = i;
+	}
+	if (sums[0])
+		fprintf(stderr, "%-8s %12ld %12.1f %12ld %6u %12.1f\n", name, sums[0],
+			(double)sums[1] / sums[0], max, worst, (double)sums[2] / sums[0]);
+}
+
+/*
+ * On tables of at most STATS_SEATS seats the chopstick waits of each
+ * seat, his left one is the chopstick he owns, his right one the
+ * chopstick of the next seat. Then how late the sleeps ended, over every
+ * seat.
+ */
+static void	print_seats(t_shared *info)
+{
+	t_seat_stats	*seat;
+	long			sleeps[3];
+	unsigned int	i;
+
+	memset(sleeps, 0, sizeof(sleeps));
+	i = 0;
+	while (i < info->num_philos)
+	{
+		seat = &info->stats[i++];
+		sleeps[0] += get(&seat->sleeps);
+		sleeps[1] += get(&seat->overslept);
+		if (get(&seat->max_overslept) > sleeps[2])
+			sleeps[2] = get(&seat->max_overslept);
+		if (info->num_philos <= STATS_SEATS)
+			fprintf(stderr, "%-8u %8ld %12ld %8ld %12ld\n", i,
+				get(&seat->locks[LOCK_LEFT].count),
+				get(&seat->locks[LOCK_LEFT].wait),
+				get(&seat->locks[LOCK_RIGHT].count),
+				get(&seat->locks[LOCK_RIGHT].wait));
+	}
+	if (sleeps[0])
+		fprintf(stderr, "sleeps %ld, overslept avg %.1f us, max %ld us\n",
+			sleeps[0], (double)sleeps[1] / sleeps[0], sleeps[2]);
+}
+
+/*
+ * The histogram of the intervals between two meals of a seat, over every
+ * seat, empty buckets are skipped.
+ */
+static void	print_intervals(t_shared *info)
+{
+	long			count;
+	unsigned int	i;
+	int				bucket;
+
+	fprintf(stderr, "meal intervals\n");
+	bucket = -1;
+	while (++bucket < STATS_BUCKETS)
+	{
+		count = 0;
+		i = 0;
+		while (i < info->num_philos)
+			count += get(&info->stats[i++].intervals[bucket]);
+		if (count)
+			fprintf(stderr, "  >= %10ld us %12ld\n", 1L << bucket, count);
+	}
+}
+
+/*
+ * Prints everything on stderr, so it never mixes with the events on
+ * stdout. The seats keep running while this reads their buffers, a dump
+ * on SIGUSR1 is a snapshot that may be a few events off.
+ */
+void	dump_stats(t_shared *info)
+{
+	fprintf(stderr, "--- philo stats, %u seats, started in %.3f ms ---\n",
+		info->num_philos, info->startup / 1e3);
+	fprintf(stderr, "%-8s %12s %12s %12s %6s %12s\n", "lock", "count",
+		"avg wait us", "max wait us", "seat", "avg hold us");
+	print_lock(info, LOCK_LEFT, "left");
+	print_lock(info, LOCK_RIGHT, "right");
+	print_lock(info, LOCK_MONITOR, "monitor");
+	if (info->num_philos <= STATS_SEATS)
+		fprintf(stderr, "%-8s %8s %12s %8s %12s\n", "seat", "left",
+			"left wait us", "right", "right wait us");
+	print_seats(info);
+	print_intervals(info);
+}
+
+#endif
@@ -0,0 +1,78 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_record.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:45:06 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:45:06 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef PHILO_STATS
+
+/*
+ * Only the thread running a seat writes its buffer, so a counter needs no
+ * read-modify-write, a relaxed load and store is enough. They are atomics
+ * only so that a dump may read them while the seats run.
+ */
+void	stat_add(atomic_long *counter, long value)
+{
+	atomic_store_explicit(counter, atomic_load_explicit(counter,
+			memory_order_relaxed) + value, memory_order_relaxed);
+}
+
+/*
+ * Same as stat_add, for a maximum.
+ */
+void	stat_max(atomic_long *counter, long value)
+{
+	if (value > atomic_load_explicit(counter, memory_order_relaxed))
+		atomic_store_explicit(counter, value, memory_order_relaxed);
+}
+
+/*
+ * Locks mutex like pthread_mutex_lock and returns what it returned. The
+ * wait is the time from the call to getting the lock, locked_at is kept
+ * for stat_release.
+ */
+int	stat_lock(t_philo *philo, t_lock which, pthread_mutex_t *mutex)
+{
+	t_lock_stats	*lock;
+	time_t			start;
+	int				ret;
+
+	start = get_time_us();
+	ret = pthread_mutex_lock(mutex);
+	lock = &philo->info->stats[philo->philo_id - 1].locks[which];
+	lock->locked_at = get_time_us();
+	stat_add(&lock->count, 1);
+	stat_add(&lock->wait, lock->locked_at - start);
+	stat_max(&lock->max_wait, lock->locked_at - start);
+	return (ret);
+}
+
+/*
+ * Adds the time since stat_lock to the time the seat held the lock.
+ */
+void	stat_release(t_philo *philo, t_lock which)
+{
+	t_lock_stats	*lock;
+
+	lock = &philo->info->stats[philo->philo_id - 1].locks[which];
+	stat_add(&lock->hold, get_time_us() - lock->locked_at);
+}
+
+/*
+ * Same as stat_release followed by pthread_mutex_unlock.
+ */
+int	stat_unlock(t_philo *philo, t_lock which, pthread_mutex_t *mutex)
+{
+	stat_release(philo, which);
+	return (pthread_mutex_unlock(mutex));
+}
+
+#endif
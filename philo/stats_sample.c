@@ -0,0 +1,55 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_sample.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:46:02 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:17:10 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+#ifdef PHILO_STATS
+
+/*
+ * How late the seat was woken up after deadline. With threads that is the
+ * futex wait, in the pool how late the worker fired the timer.
+ */
+void	stat_sleep(t_philo *philo, time_t deadline)
+{
+	t_seat_stats	*seat;
+	time_t			late;
+
+	seat = &philo->info->stats[philo->philo_id - 1];
+	late = sim_now(philo->info) - deadline;
+	if (late < 0)
+		late = 0;
+	stat_add(&seat->sleeps, 1);
+	stat_add(&seat->overslept, late);
+	stat_max(&seat->max_overslept, late);
+}
+
+/*
+ * The seat's previous meal is its deadline minus time_to_die, or the
+ * start of the simulation before the first meal. Bucket i holds the
+ * intervals of 2^i to 2^(i+1) microseconds, the last one everything
+ * longer.
+ */
+void	stat_meal(t_philo *philo, time_t meal_time)
+{
+	t_seat_stats	*seat;
+	time_t			interval;
+	int				bucket;
+
+	seat = &philo->info->stats[philo->philo_id - 1];
+	interval = meal_time - (philo->deadline - philo->profile->time_to_die);
+	bucket = 0;
+	while (bucket < STATS_BUCKETS - 1 && interval >> (bucket + 1))
+		bucket++;
+	stat_add(&seat->intervals[bucket], 1);
+}
+
+#endif
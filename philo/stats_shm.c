@@ -0,0 +1,103 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_shm.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:41:05 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:29:55 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The header, then a cache line per seat.
+ */
+static size_t	shm_size(t_shared *info)
+{
+	return (sizeof(t_shm_header) + sizeof(t_shm_seat) * info->num_philos);
+}
+
+/*
+ * Called once the table is made and --profile placed the seats, before
+ * anybody runs. The header holds the numbers of the command line, with
+ * the fewest meals a seat must eat, every seat its own time_to_die and
+ * meal target. Everything but version is set first, the seats think
+ * until they report, then version tells a reader the file is ready. A
+ * new file is all zeros, so stop is RUNNING and every seat ate nothing at
+ * the start.
+ */
+void	ready_stats_shm(t_shared *info)
+{
+	t_shm_seat		*seat;
+	unsigned int	i;
+
+	if (!info->shm)
+		return ;
+	memcpy(info->shm->magic, SHM_MAGIC, 8);
+	info->shm->num_philos = info->num_philos;
+	info->shm->time_to_die = info->time_to_die;
+	info->shm->time_to_eat = info->time_to_eat;
+	info->shm->time_to_sleep = info->time_to_sleep;
+	info->shm->num_meals = info->num_meals;
+	info->shm->pid = getpid();
+	i = 0;
+	while (i < info->num_philos)
+	{
+		seat = &info->shm_seats[i];
+		seat->time_to_die = info->table[i].profile->time_to_die;
+		seat->num_meals = info->table[i++].profile->num_meals;
+		atomic_init(&seat->state, THINKING);
+	}
+	atomic_store_explicit(&info->shm->version, SHM_VERSION,
+		memory_order_release);
+}
+
+/*
+ * --stats-shm=FILE: what a monitor wants to know of a running simulation
+ * is published in a shared mapping of FILE, /dev/shm/NAME keeps it in
+ * memory, so it can be watched without parsing the output, even with
+ * --trace. Every seat is published by the thread running it with plain
+ * atomic stores in its own cache line, no lock is taken, a reader never
+ * holds anybody back. The file is truncated first, so an old one of the
+ * same name starts over. Readers wait until ready_stats_shm filled it.
+ * Returns 0 if the file cannot be created or mapped, else 1.
+ */
+int	open_stats_shm(t_shared *info)
+{
+	int	fd;
+
+	info->shm = NULL;
+	if (!info->opt.stats_shm)
+		return (1);
+	fd = open(info->opt.stats_shm, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	if (fd >= 0 && !ftruncate(fd, shm_size(info)))
+		info->shm = mmap(NULL, shm_size(info), PROT_READ | PROT_WRITE,
+				MAP_SHARED, fd, 0);
+	if (fd >= 0)
+		close(fd);
+	if (info->shm == MAP_FAILED || !info->shm)
+	{
+		info->shm = NULL;
+		printf("Error: Cannot map the stats file.\n");
+		return (0);
+	}
+	info->shm_seats = (t_shm_seat *)(info->shm + 1);
+	return (1);
+}
+
+/*
+ * Called once every producer is done, stop already holds the outcome.
+ * The clock is left at the end of the run.
+ */
+void	close_stats_shm(t_shared *info)
+{
+	if (!info->shm)
+		return ;
+	if (!info->opt.virtual_time)
+		publish_clock(info, get_time_us() - info->sim_start_time);
+	munmap(info->shm, shm_size(info));
+	info->shm = NULL;
+}
@@ -0,0 +1,81 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stats_shm_publish.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:41:05 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:08:47 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The writer side of the sequence lock of the seat, like record_meal.
+ * The seat was last written by the thread running it, or by the worker
+ * that ran it before, which handed it over through a queue, so the
+ * sequence never has two writers at once.
+ */
+void	publish_meal(t_philo *philo, time_t meal_time, int times_eaten)
+{
+	t_shm_seat		*seat;
+	unsigned int	seq;
+
+	if (!philo->info->shm)
+		return ;
+	seat = &philo->info->shm_seats[philo->philo_id - 1];
+	seq = atomic_load_explicit(&seat->seq, memory_order_relaxed);
+	atomic_store_explicit(&seat->seq, seq + 1, memory_order_relaxed);
+	atomic_thread_fence(memory_order_release);
+	atomic_store_explicit(&seat->last_meal,
+		meal_time - philo->info->sim_start_time, memory_order_relaxed);
+	atomic_store_explicit(&seat->times_eaten, times_eaten,
+		memory_order_relaxed);
+	atomic_store_explicit(&seat->seq, seq + 2, memory_order_release);
+}
+
+/*
+ * A single word, it needs no sequence. The all full line is no seat's.
+ */
+void	publish_state(t_shared *info, unsigned int id, t_state state)
+{
+	if (!info->shm || id == 0 || id > info->num_philos)
+		return ;
+	atomic_store_explicit(&info->shm_seats[id - 1].state, state,
+		memory_order_relaxed);
+}
+
+/*
+ * A reader measures the hunger of the seats against it.
+ */
+void	publish_clock(t_shared *info, time_t now)
+{
+	if (!info->shm)
+		return ;
+	atomic_store_explicit(&info->shm->now, now, memory_order_relaxed);
+}
+
+/*
+ * ate_max_meal, by whoever incremented the one of the shared info. It is
+ * incremented here as well, two seats getting full at once could store
+ * their counts out of order.
+ */
+void	publish_full(t_shared *info)
+{
+	if (!info->shm)
+		return ;
+	atomic_fetch_add_explicit(&info->shm->ate_max_meal, 1,
+		memory_order_relaxed);
+}
+
+/*
+ * By the one call of stop_simulation that stopped it.
+ */
+void	publish_stop(t_shared *info, t_stop reason)
+{
+	if (!info->shm)
+		return ;
+	atomic_store_explicit(&info->shm->stop, reason, memory_order_relaxed);
+}
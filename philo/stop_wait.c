@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   stop_wait.c                                        :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:08:33 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:52:21 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Blocks the calling thread while the word still holds expected, at most
+ * until the absolute deadline of CLOCK_MONOTONIC, which is what
+ * FUTEX_WAIT_BITSET measures its timeout against.
+ */
+void	futex_wait_until(atomic_int *word, int expected, time_t deadline)
+{
+	struct timespec	until;
+
+	us_to_timespec(deadline, &until);
+	syscall(SYS_futex, word, FUTEX_WAIT_BITSET | FUTEX_PRIVATE_FLAG,
+		expected, &until, NULL, FUTEX_BITSET_MATCH_ANY);
+}
+
+/*
+ * Sleeps until the absolute deadline, in microseconds of get_time_us, or
+ * until the simulation stops, whichever comes first. The thread sleeps in
+ * the kernel on the stop epoch itself, so there is no wakeup in between
+ * and no lock is taken. stop_simulation wakes every sleeper at once.
+ * A wakeup for any other reason (a signal) simply waits again.
+ * Returns 0 if the simulation stopped, else 1.
+ */
+int	sleep_until(t_shared *info, time_t deadline)
+{
+	while (atomic_load(&info->stop_epoch) == RUNNING)
+	{
+		if (get_time_us() >= deadline)
+			return (1);
+		futex_wait_until(&info->stop_epoch, RUNNING, deadline);
+	}
+	return (0);
+}
+
+/*
+ * Blocks the seat until a neighbour bumps its grant past expected, see
+ * grant_seat. The grant was read under the lock the neighbour takes to
+ * bump it, so a bump in between is never missed.
+ */
+void	wait_for_grant(t_philo *philo, int expected)
+{
+	while (atomic_load(&philo->grant) == expected)
+		futex_wait_until(&philo->grant, expected, get_time_us() + 1000000);
+}
+
+/*
+ * Wakes up to count threads blocked in futex_wait_until on the word.
+ */
+void	futex_wake(atomic_int *word, int count)
+{
+	syscall(SYS_futex, word, FUTEX_WAKE | FUTEX_PRIVATE_FLAG,
+		count, NULL, NULL, 0);
+}
+
+/*
+ * Wakes every thread sleeping in sleep_until, called once the stop epoch
+ * changed.
+ */
+void	wake_sleepers(t_shared *info)
+{
+	futex_wake(&info->stop_epoch, INT_MAX);
+}
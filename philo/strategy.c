@@ -0,0 +1,114 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:52:21 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:02:19 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Initializes the chopstick i - 1, to the left of the seat i, for every
+ * strategy. With chandy-misra every fork starts dirty at the lower
+ * numbered of its two seats, the seats i - 1 and i, or 1 and num_philos
+ * for the first fork, so the forks never form a cycle of seats waiting
+ * on each other.
+ * If the initialization of the mutex fails, 0 is returned, else 1.
+ */
+int	init_chopstick(t_chopstick *chopstick, unsigned int i)
+{
+	if (pthread_mutex_init(&chopstick->mutex, NULL))
+	{
+		printf("Error: Mutex initialization failed.\n");
+		return (0);
+	}
+	chopstick->taken = false;
+	chopstick->waiter = NULL;
+	chopstick->dirty = true;
+	chopstick->owner = i - 1;
+	if (i == 1)
+		chopstick->owner = 1;
+	atomic_init(&chopstick->next_ticket, 0);
+	atomic_init(&chopstick->now_serving, 0);
+	return (1);
+}
+
+/*
+ * Returns the left or the right chopstick of the seat.
+ */
+t_chopstick	*chopstick_of(t_philo *philo, t_lock which)
+{
+	if (which == LOCK_LEFT)
+		return (l_chopstick(philo));
+	return (r_chopstick(philo));
+}
+
+/*
+ * The chopsticks are numbered by their index, every seat wants the lower
+ * numbered one of his two first. That is his left one, except for the
+ * last seat, whose right one is the first chopstick. Since nobody ever
+ * waits for a lower numbered chopstick while holding a higher one, no
+ * cycle of waiting seats can form.
+ */
+t_lock	first_lock(t_philo *philo)
+{
+	if (philo->philo_id == philo->info->num_philos)
+		return (LOCK_RIGHT);
+	return (LOCK_LEFT);
+}
+
+/*
+ * Gets both chopsticks the way the strategy says and reports them.
+ * The default strategy, and a lonely philosopher whatever the strategy,
+ * go through take_chopsticks. The other strategies only hand out both
+ * chopsticks at once, so both are reported then.
+ * If an error occures or the simulation stopped, whatever is held is put
+ * back and 0 is returned, else 1 is returned.
+ */
+int	acquire_chopsticks(t_philo *philo)
+{
+	t_strategy	strategy;
+	int			ok;
+
+	strategy = philo->info->opt.strategy;
+	if (strategy == STRATEGY_DEFAULT || philo->info->num_philos == 1)
+		return (take_chopsticks(philo));
+	if (strategy == STRATEGY_HIERARCHY || strategy == STRATEGY_TICKET)
+		ok = take_in_order(philo);
+	else if (strategy == STRATEGY_WAITER || strategy == STRATEGY_EDF)
+		ok = ask_waiter(philo);
+	else if (strategy == STRATEGY_SCHEDULE)
+		ok = wait_slot(philo);
+	else
+		ok = take_forks(philo);
+	if (!ok)
+		return (0);
+	if (!report_philo_state(philo, FIRST_CHOPSTICK)
+		|| !report_philo_state(philo, SECOND_CHOPSTICK))
+	{
+		release_chopsticks(philo);
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * Puts both chopsticks back the way the strategy says. The default, the
+ * hierarchy, the ticket and the schedule strategies simply hold both
+ * chopstick locks.
+ * Returns 0 in case of errors, else 1.
+ */
+int	release_chopsticks(t_philo *philo)
+{
+	if (philo->info->opt.strategy == STRATEGY_WAITER
+		|| philo->info->opt.strategy == STRATEGY_EDF)
+		return (thank_waiter(philo));
+	if (philo->info->opt.strategy == STRATEGY_CHANDY_MISRA)
+		return (put_forks(philo));
+	return (unlock_chopsticks(philo));
+}
@@ -0,0 +1,130 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_chandy_misra.c                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:52:21 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:52:21 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Bumps the grant of the seat and wakes it up, see wait_for_grant.
+ */
+void	grant_seat(t_philo *philo)
+{
+	atomic_fetch_add(&philo->grant, 1);
+	futex_wake(&philo->grant, 1);
+}
+
+/*
+ * Makes the seat the owner of the fork. A dirty fork that is not being
+ * eaten with is simply taken, and cleaned. A clean one, or one in use,
+ * is asked for by becoming its waiter, then the seat blocks until its
+ * owner hands it over in put_fork.
+ * Returns 0 if a lock fails, else 1.
+ */
+static int	request_fork(t_philo *philo, t_chopstick *fork)
+{
+	int	grant;
+
+	if (pthread_mutex_lock(&fork->mutex))
+		return (0);
+	while (fork->owner != philo->philo_id)
+	{
+		if (fork->dirty && !fork->taken)
+		{
+			fork->owner = philo->philo_id;
+			fork->dirty = false;
+			continue ;
+		}
+		fork->waiter = philo;
+		grant = atomic_load(&philo->grant);
+		pthread_mutex_unlock(&fork->mutex);
+		wait_for_grant(philo, grant);
+		if (pthread_mutex_lock(&fork->mutex))
+			return (0);
+	}
+	if (fork->waiter == philo)
+		fork->waiter = NULL;
+	pthread_mutex_unlock(&fork->mutex);
+	return (1);
+}
+
+/*
+ * --strategy=chandy-misra: every fork is always owned by one of its two
+ * seats, and is either clean or dirty. A hungry seat requests the forks
+ * it does not own. Forks are dirty after a meal and a dirty fork goes to
+ * whoever asks for it, even from a hungry seat, while a clean fork is
+ * kept until its owner ate. So a seat that just ate yields to the one
+ * waiting, nobody starves while his neighbours eat in turns, and as the
+ * forks start acyclic, nobody deadlocks.
+ * A dirty fork of the seat itself may be taken away while it requests
+ * the other one, then it requests again. Once both are his, both forks
+ * are marked taken under both mutexes, in the order of first_lock.
+ * Returns 0 if a lock fails, else 1.
+ */
+int	take_forks(t_philo *philo)
+{
+	t_chopstick	*first;
+	t_chopstick	*second;
+	bool		both;
+
+	first = chopstick_of(philo, first_lock(philo));
+	second = l_chopstick(philo);
+	if (first == second)
+		second = r_chopstick(philo);
+	both = false;
+	while (!both)
+	{
+		if (!request_fork(philo, first) || !request_fork(philo, second)
+			|| pthread_mutex_lock(&first->mutex))
+			return (0);
+		pthread_mutex_lock(&second->mutex);
+		both = (first->owner == philo->philo_id
+				&& second->owner == philo->philo_id);
+		first->taken = both;
+		second->taken = both;
+		pthread_mutex_unlock(&second->mutex);
+		pthread_mutex_unlock(&first->mutex);
+	}
+	return (1);
+}
+
+/*
+ * The meal made the fork dirty. If the neighbour asked for it meanwhile
+ * it goes to him right away, cleaned.
+ */
+static void	put_fork(t_chopstick *fork)
+{
+	t_philo	*waiter;
+
+	pthread_mutex_lock(&fork->mutex);
+	fork->taken = false;
+	fork->dirty = true;
+	waiter = fork->waiter;
+	fork->waiter = NULL;
+	if (waiter)
+	{
+		fork->owner = waiter->philo_id;
+		fork->dirty = false;
+	}
+	pthread_mutex_unlock(&fork->mutex);
+	if (waiter)
+		grant_seat(waiter);
+}
+
+/*
+ * Puts both forks down after the meal.
+ * Returns 1.
+ */
+int	put_forks(t_philo *philo)
+{
+	put_fork(r_chopstick(philo));
+	put_fork(l_chopstick(philo));
+	return (1);
+}
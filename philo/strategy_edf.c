@@ -0,0 +1,76 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_edf.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:59:33 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:17:10 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * When the seat starves if it does not eat again. The seat's own
+ * deadline is guarded by the monitor mutex, this is the same time from
+ * the lock free last meal.
+ */
+static time_t	due(t_philo *philo)
+{
+	return (atomic_load_explicit(&philo->last_meal_time, memory_order_relaxed)
+		+ philo->profile->time_to_die);
+}
+
+/*
+ * Returns the seat to the left or to the right of the seat.
+ */
+t_philo	*neighbour_of(t_philo *philo, t_lock which)
+{
+	unsigned int	n;
+
+	n = philo->info->num_philos;
+	if (which == LOCK_LEFT)
+		return (&philo->info->table[(philo->philo_id + n - 2) % n]);
+	return (&philo->info->table[philo->philo_id % n]);
+}
+
+/*
+ * --strategy=edf is the waiter, but a seat never takes a chopstick a
+ * hungry neighbour who starves strictly earlier is waiting for, even if
+ * both are free: the chopstick is kept for him, nobody barges in. Equal
+ * deadlines go to whoever asks first. Called with the waiter mutex held.
+ * Returns true if the seat must let a neighbour go first.
+ */
+bool	yields(t_philo *philo)
+{
+	t_philo	*left;
+	t_philo	*right;
+
+	if (philo->info->opt.strategy != STRATEGY_EDF)
+		return (false);
+	left = neighbour_of(philo, LOCK_LEFT);
+	right = neighbour_of(philo, LOCK_RIGHT);
+	return ((left->hungry && due(left) < due(philo))
+		|| (right->hungry && due(right) < due(philo)));
+}
+
+/*
+ * The two neighbours the waiter looks at once the seat put its
+ * chopsticks back, with edf the one starving first comes first.
+ */
+void	serve_order(t_philo *philo, t_philo **first, t_philo **second)
+{
+	t_philo	*tmp;
+
+	*first = neighbour_of(philo, LOCK_LEFT);
+	*second = neighbour_of(philo, LOCK_RIGHT);
+	if (philo->info->opt.strategy == STRATEGY_EDF
+		&& due(*second) < due(*first))
+	{
+		tmp = *first;
+		*first = *second;
+		*second = tmp;
+	}
+}
@@ -0,0 +1,42 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_order.c                                   :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:52:21 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:11:43 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * --strategy=hierarchy and ticket: the chopsticks are held for the meal
+ * like by default, but taken in the order of first_lock, so no seat
+ * needs to start late to avoid a deadlock.
+ * Returns 0 if a lock fails, else 1.
+ */
+int	take_in_order(t_philo *philo)
+{
+	t_lock	first;
+	t_lock	second;
+
+	first = first_lock(philo);
+	second = LOCK_LEFT;
+	if (first == LOCK_LEFT)
+		second = LOCK_RIGHT;
+	if (lock_chopstick(philo, first))
+	{
+		printf("Error: Chopstick mutex lock failed.\n");
+		return (0);
+	}
+	if (lock_chopstick(philo, second))
+	{
+		unlock_chopstick(philo, first);
+		printf("Error: Chopstick mutex lock failed.\n");
+		return (0);
+	}
+	return (1);
+}
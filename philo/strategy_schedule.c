@@ -0,0 +1,93 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_schedule.c                                :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:56:19 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:56:19 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The length of one round of the schedule: every group eats once, one
+ * after the other, and the first one must also have slept before it eats
+ * again. An even table has two groups, the odd and the even seats, an
+ * odd one needs a third for its last seat, whose neighbours are the
+ * first and the one before him, one of each group.
+ */
+static time_t	period_of(t_shared *info)
+{
+	time_t	groups;
+
+	groups = 2 + info->num_philos % 2;
+	if (groups * info->time_to_eat > info->time_to_eat + info->time_to_sleep)
+		return (groups * info->time_to_eat);
+	return (info->time_to_eat + info->time_to_sleep);
+}
+
+/*
+ * Which group the seat eats with, the groups go in order, each a meal
+ * after the one before.
+ */
+static time_t	group_of(t_philo *philo)
+{
+	if (philo->info->num_philos % 2
+		&& philo->philo_id == philo->info->num_philos)
+		return (2);
+	return ((philo->philo_id - 1) % 2);
+}
+
+/*
+ * --strategy=schedule is only run if its plan feeds every seat in time.
+ * The first group eats at the start and then once every period, so if
+ * the period is not shorter than time_to_die, seat 1 starves at
+ * time_to_die, before anybody else could: a later group eats first at
+ * most two meals later and would die as much later. A lonely seat never
+ * has two chopsticks and dies then too. The prediction is printed and
+ * the simulation does not start. The plan is for a table whose seats
+ * all have the same times, there is none with --profile.
+ * Returns 0 if there is no plan, else 1.
+ */
+int	check_schedule(t_shared *info)
+{
+	time_t	period;
+
+	if (info->opt.strategy != STRATEGY_SCHEDULE)
+		return (1);
+	if (info->opt.profile)
+	{
+		printf("Error: --strategy=schedule takes no --profile.\n");
+		return (0);
+	}
+	period = period_of(info);
+	if (info->num_philos > 1 && period < info->time_to_die)
+		return (1);
+	printf("Error: No schedule, the period is %ld ms, philo 1 would die "
+		"at %ld ms.\n", period / 1000, info->time_to_die / 1000);
+	return (0);
+}
+
+/*
+ * --strategy=schedule: the seat waits, thinking, for the start of its
+ * next meal in the plan, the start of its group in the round of its
+ * meal count, an absolute time, so a seat that ran late does not shift
+ * the ones after. Then it takes its chopsticks in the hierarchy order,
+ * they are free unless a neighbour ran late, who would not be for long.
+ * Returns 0 if the simulation stopped or a lock fails, else 1.
+ */
+int	wait_slot(t_philo *philo)
+{
+	time_t	slot;
+
+	slot = philo->info->sim_start_time
+		+ group_of(philo) * philo->info->time_to_eat
+		+ atomic_load_explicit(&philo->times_eaten, memory_order_relaxed)
+		* period_of(philo->info);
+	if (!sleep_until(philo->info, slot))
+		return (0);
+	return (take_in_order(philo));
+}
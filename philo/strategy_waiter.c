@@ -0,0 +1,105 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   strategy_waiter.c                                  :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:52:21 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:59:33 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * A seat may be served when neither of its chopsticks is taken, that is
+ * when neither neighbour eats, and, with edf, no neighbour goes first.
+ * Called with the waiter mutex held.
+ */
+static bool	can_eat(t_philo *philo)
+{
+	return (!l_chopstick(philo)->taken && !r_chopstick(philo)->taken
+		&& !yields(philo));
+}
+
+/*
+ * Hands both chopsticks to the seat. Called with the waiter mutex held.
+ */
+static void	serve(t_philo *philo)
+{
+	l_chopstick(philo)->taken = true;
+	r_chopstick(philo)->taken = true;
+	philo->hungry = false;
+}
+
+/*
+ * --strategy=waiter: a single waiter, the mutex of the same name, hands
+ * out both chopsticks of a seat at once, only when both are free. A seat
+ * that cannot be served yet is marked hungry and blocks on its grant
+ * until a neighbour serves it on his way out, so a seat never holds one
+ * chopstick while waiting for the other.
+ * Returns 0 if a lock fails, else 1.
+ */
+int	ask_waiter(t_philo *philo)
+{
+	int	grant;
+
+	if (pthread_mutex_lock(&philo->info->waiter))
+	{
+		printf("Error: Mutex lock failed.\n");
+		return (0);
+	}
+	philo->hungry = true;
+	if (can_eat(philo))
+		serve(philo);
+	while (philo->hungry)
+	{
+		grant = atomic_load(&philo->grant);
+		pthread_mutex_unlock(&philo->info->waiter);
+		wait_for_grant(philo, grant);
+		if (pthread_mutex_lock(&philo->info->waiter))
+		{
+			printf("Error: Mutex lock failed.\n");
+			return (0);
+		}
+	}
+	pthread_mutex_unlock(&philo->info->waiter);
+	return (1);
+}
+
+/*
+ * Serves the neighbour if he is hungry and can eat now, and wakes him up.
+ * Called with the waiter mutex held.
+ */
+static void	serve_neighbour(t_philo *neighbour)
+{
+	if (!neighbour->hungry || !can_eat(neighbour))
+		return ;
+	serve(neighbour);
+	grant_seat(neighbour);
+}
+
+/*
+ * Gives both chopsticks back to the waiter, who serves whichever
+ * neighbour they make able to eat, see serve_order.
+ * Returns 0 if a lock fails, else 1.
+ */
+int	thank_waiter(t_philo *philo)
+{
+	t_philo	*first;
+	t_philo	*second;
+
+	if (pthread_mutex_lock(&philo->info->waiter))
+	{
+		printf("Error: Mutex lock failed.\n");
+		return (0);
+	}
+	l_chopstick(philo)->taken = false;
+	r_chopstick(philo)->taken = false;
+	serve_order(philo, &first, &second);
+	serve_neighbour(first);
+	serve_neighbour(second);
+	pthread_mutex_unlock(&philo->info->waiter);
+	return (1);
+}
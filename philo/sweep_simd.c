@@ -0,0 +1,139 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   sweep_simd.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:59:36 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:02:09 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+#if defined(__x86_64__) || defined(__i386__)
+# include <immintrin.h>
+#endif
+
+/*
+ * The scalar sweep, one relaxed load per seat. It is the one the thread
+ * sanitizer sees, the vector loads below are not atomic to it.
+ */
+static time_t	sweep_scalar(_Atomic time_t *deadlines, size_t count)
+{
+	time_t	earliest;
+	time_t	deadline;
+	size_t	i;
+
+	earliest = LONG_MAX;
+	i = 0;
+	while (i < count)
+	{
+		deadline = atomic_load_explicit(&deadlines[i++],
+				memory_order_relaxed);
+		if (deadline < earliest)
+			earliest = deadline;
+	}
+	return (earliest);
+}
+
+#if defined(__x86_64__) || defined(__i386__)
+
+/*
+ * The earliest of the lanes a vector sweep stored and of earliest.
+ */
+static time_t	min_of(const time_t *lanes, size_t count, time_t earliest)
+{
+	while (count-- > 0)
+		if (lanes[count] < earliest)
+			earliest = lanes[count];
+	return (earliest);
+}
+
+/*
+ * Four deadlines at once, two lanes apart, each lane keeps the earlier
+ * of what it holds and the new deadline, with a compare and a blend, AVX2
+ * has no 64 bit min. An aligned 8 byte lane is read whole on x86, a seat
+ * storing its deadline meanwhile is seen before or after, never torn.
+ * The array is cache line aligned, each sweeper starts on a multiple of
+ * 8 seats.
+ */
+__attribute__((target("avx2")))
+static time_t	sweep_avx2(_Atomic time_t *deadlines, size_t count)
+{
+	__m256i	lanes[2];
+	__m256i	next[2];
+	time_t	out[4];
+	size_t	i;
+
+	lanes[0] = _mm256_set1_epi64x(LONG_MAX);
+	lanes[1] = lanes[0];
+	i = 0;
+	while (i + 8 <= count)
+	{
+		next[0] = _mm256_load_si256((__m256i *)(void *)(deadlines + i));
+		next[1] = _mm256_load_si256((__m256i *)(void *)(deadlines + i + 4));
+		lanes[0] = _mm256_blendv_epi8(lanes[0], next[0],
+				_mm256_cmpgt_epi64(lanes[0], next[0]));
+		lanes[1] = _mm256_blendv_epi8(lanes[1], next[1],
+				_mm256_cmpgt_epi64(lanes[1], next[1]));
+		i += 8;
+	}
+	lanes[0] = _mm256_blendv_epi8(lanes[0], lanes[1],
+			_mm256_cmpgt_epi64(lanes[0], lanes[1]));
+	_mm256_storeu_si256((__m256i *)out, lanes[0]);
+	return (min_of(out, 4, sweep_scalar(deadlines + i, count - i)));
+}
+
+/*
+ * The same, two deadlines at once. The 64 bit compare is SSE4.2, SSE2
+ * has none.
+ */
+__attribute__((target("sse4.2")))
+static time_t	sweep_sse42(_Atomic time_t *deadlines, size_t count)
+{
+	__m128i	lanes[2];
+	__m128i	next[2];
+	time_t	out[4];
+	size_t	i;
+
+	lanes[0] = _mm_set1_epi64x(LONG_MAX);
+	lanes[1] = lanes[0];
+	i = 0;
+	while (i + 4 <= count)
+	{
+		next[0] = _mm_load_si128((__m128i *)(void *)(deadlines + i));
+		next[1] = _mm_load_si128((__m128i *)(void *)(deadlines + i + 2));
+		lanes[0] = _mm_blendv_epi8(lanes[0], next[0],
+				_mm_cmpgt_epi64(lanes[0], next[0]));
+		lanes[1] = _mm_blendv_epi8(lanes[1], next[1],
+				_mm_cmpgt_epi64(lanes[1], next[1]));
+		i += 4;
+	}
+	_mm_storeu_si128((__m128i *)out, lanes[0]);
+	_mm_storeu_si128((__m128i *)(out + 2), lanes[1]);
+	return (min_of(out, 4, sweep_scalar(deadlines + i, count - i)));
+}
+
+#endif
+
+/*
+ * SIMD_BEST is the widest the CPU runs, and always the scalar sweep
+ * under the thread sanitizer, so it checks what the seats store against
+ * atomic loads.
+ */
+t_sweep	pick_sweep(t_simd simd)
+{
+#if defined(__x86_64__) || defined(__i386__)
+	__builtin_cpu_init();
+	if ((simd == SIMD_BEST || simd == SIMD_AVX2)
+		&& __builtin_cpu_supports("avx2") && !SWEEP_SANITIZED)
+		return (sweep_avx2);
+	if ((simd == SIMD_BEST || simd == SIMD_SSE42)
+		&& __builtin_cpu_supports("sse4.2") && !SWEEP_SANITIZED)
+		return (sweep_sse42);
+#endif
+	if (simd == SIMD_BEST || simd == SIMD_SCALAR)
+		return (sweep_scalar);
+	return (NULL);
+}
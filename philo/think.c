@@ -0,0 +1,75 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   think.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 03:42:00 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 03:42:00 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * A seat starts without any measurement and does not think until the
+ * cycles it ate give it some.
+ */
+void	reset_think(t_philo *philo)
+{
+	philo->think = 0;
+	philo->hungry_at = 0;
+	philo->ate_at = 0;
+}
+
+/*
+ * Measures the cycle that ended with the meal starting at meal: how long
+ * the seat waited for its chopsticks since it got hungry, and how much of
+ * time_to_die was left when it ate. A wait longer than THINK_SETTLE means
+ * a neighbour was eating, half of it is moved into the think time, the
+ * seat stays off the chopstick instead of contending for it. Without any
+ * wait it thinks a quarter less, it may have been thinking for nothing,
+ * unless the slack was below the margin: the table is tight then, and a
+ * seat that came hungry earlier would take the turn of a neighbour.
+ */
+static void	steer_think(t_philo *philo, time_t meal, time_t margin)
+{
+	time_t	wait;
+
+	wait = 0;
+	if (philo->hungry_at && meal > philo->hungry_at)
+		wait = meal - philo->hungry_at;
+	if (wait > THINK_SETTLE)
+		philo->think += wait / 2;
+	else if (!philo->ate_at
+		|| philo->profile->time_to_die - (meal - philo->ate_at) >= margin)
+		philo->think -= philo->think / 4;
+	philo->ate_at = meal;
+}
+
+/*
+ * --think=adaptive: the think time follows the measurements of every
+ * cycle, see steer_think, but the seat is always hungry again at least
+ * a THINK_MARGIN-th of time_to_die before it would starve. Remembers
+ * when that is.
+ */
+time_t	adaptive_think(t_philo *philo)
+{
+	time_t	now;
+	time_t	meal;
+	time_t	margin;
+	time_t	limit;
+
+	now = sim_now(philo->info);
+	meal = atomic_load_explicit(&philo->last_meal_time, memory_order_relaxed);
+	margin = philo->profile->time_to_die / THINK_MARGIN;
+	steer_think(philo, meal, margin);
+	limit = philo->profile->time_to_die - (now - meal) - margin;
+	if (philo->think > limit)
+		philo->think = limit;
+	if (philo->think < 0)
+		philo->think = 0;
+	philo->hungry_at = now + philo->think;
+	return (philo->think);
+}
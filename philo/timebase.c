@@ -0,0 +1,96 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   timebase.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:07:08 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:07:08 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * get_time_us:	The precise clock of the simulation, in microseconds of
+ * 				CLOCK_MONOTONIC. Unlike gettimeofday it never jumps when the
+ * 				system time is set, so durations computed from it cannot go
+ * 				backwards. It is used for everything that is printed or
+ * 				compared against a deadline. Returns 0 if clock_gettime
+ * 				fails.
+ */
+time_t	get_time_us(void)
+{
+	struct timespec	now;
+
+	if (clock_gettime(CLOCK_MONOTONIC, &now))
+	{
+		printf("Error: clock_gettime failed.\n");
+		return (0);
+	}
+	return (now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+/*
+ * get_coarse_time_us:	The fast path, CLOCK_MONOTONIC_COARSE is the time
+ * 						of the last timer tick, read without touching the
+ * 						hardware counter. It is never ahead of get_time_us,
+ * 						and behind by at most the coarse_slack of the
+ * 						shared info. Returns 0 if clock_gettime fails.
+ */
+time_t	get_coarse_time_us(void)
+{
+	struct timespec	now;
+
+	if (clock_gettime(CLOCK_MONOTONIC_COARSE, &now))
+		return (0);
+	return (now.tv_sec * 1000000 + now.tv_nsec / 1000);
+}
+
+/*
+ * Returns the resolution of the coarse clock in microseconds, rounded up,
+ * a coarse time plus this slack is never behind the precise clock.
+ */
+time_t	get_coarse_slack_us(void)
+{
+	struct timespec	res;
+
+	if (clock_getres(CLOCK_MONOTONIC_COARSE, &res))
+		return (1000000);
+	return (res.tv_sec * 1000000 + (res.tv_nsec + 999) / 1000);
+}
+
+/*
+ * Converts a time given in milliseconds on the command line to
+ * microseconds. Up to three decimals are kept, so "0.5" is 500us, this
+ * allows time_to_eat and time_to_sleep below a millisecond.
+ */
+time_t	ms_to_us(const char *str)
+{
+	time_t	us;
+	time_t	scale;
+
+	us = ft_atol(str) * 1000;
+	while (*str && *str != '.')
+		str++;
+	if (*str == '.')
+		str++;
+	scale = 100;
+	while (scale && '0' <= *str && *str <= '9')
+	{
+		us += (*str++ - '0') * scale;
+		scale /= 10;
+	}
+	return (us);
+}
+
+/*
+ * Fills a timespec with an absolute time in microseconds of
+ * CLOCK_MONOTONIC, for the timed waits.
+ */
+void	us_to_timespec(time_t us, struct timespec *ts)
+{
+	ts->tv_sec = us / 1000000;
+	ts->tv_nsec = (us % 1000000) * 1000;
+}
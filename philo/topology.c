@@ -0,0 +1,125 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   topology.c                                         :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:15:05 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:15:05 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Reads the first line of a sysfs file into buf. Returns false if there
+ * is no such file.
+ */
+static bool	read_line(const char *path, char *buf, int size)
+{
+	int		fd;
+	ssize_t	len;
+
+	fd = open(path, O_RDONLY);
+	if (fd < 0)
+		return (false);
+	len = read(fd, buf, size - 1);
+	close(fd);
+	if (len <= 0)
+		return (false);
+	buf[len] = '\0';
+	return (true);
+}
+
+/*
+ * The sort key of a CPU: the first CPU sharing its L3, then the first
+ * one sharing its L2, then the CPU itself, so sorting the keys puts the
+ * CPUs of a cluster next to each other. A cache level sysfs does not
+ * describe counts as private to the CPU.
+ */
+static long	cache_key(int cpu)
+{
+	char	path[96];
+	char	buf[64];
+	long	first[4];
+	int		index;
+	int		level;
+
+	first[2] = cpu;
+	first[3] = cpu;
+	index = -1;
+	while (++index < 8)
+	{
+		snprintf(path, sizeof(path),
+			"/sys/devices/system/cpu/cpu%d/cache/index%d/level", cpu, index);
+		if (!read_line(path, buf, sizeof(buf)))
+			break ;
+		level = atoi(buf);
+		snprintf(path, sizeof(path), "/sys/devices/system/cpu/cpu%d/cache/"
+			"index%d/shared_cpu_list", cpu, index);
+		if ((level == 2 || level == 3) && read_line(path, buf, sizeof(buf)))
+			first[level] = atoi(buf);
+	}
+	return ((first[3] << 40) | (first[2] << 20) | cpu);
+}
+
+static int	compare_keys(const void *a, const void *b)
+{
+	return ((*(const long *)a > *(const long *)b)
+		- (*(const long *)a < *(const long *)b));
+}
+
+/*
+ * --pin: lists the CPUs the process may run on in the order of the cache
+ * clusters: the keys of cache_key are sorted in place, the CPU is in
+ * their low 20 bits. --pin-referee keeps the last of them for the
+ * calling thread, the referee, and for the writer it starts after.
+ * Returns 0 if anything fails, else 1.
+ */
+int	setup_pinning(t_shared *info)
+{
+	cpu_set_t	set;
+	int			cpu;
+
+	if (!info->opt.pin)
+		return (1);
+	info->cpus = malloc(sizeof(long) * CPU_SETSIZE);
+	if (!info->cpus || sched_getaffinity(0, sizeof(set), &set))
+	{
+		printf("Error: Reading the CPU topology failed.\n");
+		return (0);
+	}
+	info->num_cpus = 0;
+	cpu = -1;
+	while (++cpu < CPU_SETSIZE)
+		if (CPU_ISSET(cpu, &set))
+			info->cpus[info->num_cpus++] = cache_key(cpu);
+	qsort(info->cpus, info->num_cpus, sizeof(long), compare_keys);
+	if (info->opt.pin_referee && info->num_cpus > 1)
+	{
+		info->num_cpus--;
+		pin_seat(info, pthread_self(), 1, 1);
+	}
+	return (1);
+}
+
+/*
+ * Pins the thread i of count, a philosopher or a worker, with --pin. The
+ * threads are cut in contiguous runs of the ring, one per CPU in cluster
+ * order, so only the chopsticks at the ends of a run are shared with
+ * another CPU, and mostly with one of the same cluster. The thread count
+ * of count would get the CPU right after the last run, that is the one
+ * kept for the referee.
+ */
+void	pin_seat(t_shared *info, pthread_t thread, unsigned int i,
+		unsigned int count)
+{
+	cpu_set_t	set;
+
+	if (!info->opt.pin)
+		return ;
+	CPU_ZERO(&set);
+	CPU_SET(info->cpus[(long)i * info->num_cpus / count] & 0xFFFFF, &set);
+	pthread_setaffinity_np(thread, sizeof(set), &set);
+}
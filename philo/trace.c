@@ -0,0 +1,137 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace.c                                            :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:24:59 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:33:35 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Where the records start, the header and the counts of the regions
+ * rounded up to a page.
+ */
+size_t	trace_offset(unsigned int num_regions)
+{
+	size_t	size;
+
+	size = sizeof(t_trace_header) + sizeof(uint64_t) * num_regions;
+	return ((size + TRACE_PAGE - 1) / TRACE_PAGE * TRACE_PAGE);
+}
+
+/*
+ * Creates the file, sized up front, and maps it. It stays sparse, only
+ * the pages written take space. The first write to a page of a region
+ * faults it in, by default the kernel would read ahead the holes around
+ * it too, which took hundreds of microseconds per fault while the
+ * philosophers wait, MADV_RANDOM keeps a fault to the page itself.
+ * The lock for growing the file is made here too.
+ * Returns 0 if anything fails, else 1.
+ */
+static int	map_trace(t_writer *writer, const char *path)
+{
+	writer->trace_fd = open(path, O_RDWR | O_CREAT | O_TRUNC, 0644);
+	writer->trace = MAP_FAILED;
+	if (writer->trace_fd >= 0 && !ftruncate(writer->trace_fd,
+			writer->trace_size))
+		writer->trace = mmap(NULL, writer->trace_size, PROT_READ
+				| PROT_WRITE, MAP_SHARED, writer->trace_fd, 0);
+	if (writer->trace != MAP_FAILED
+		&& !pthread_mutex_init(&writer->trace_lock, NULL))
+	{
+		madvise(writer->trace, writer->trace_size, MADV_RANDOM);
+		return (1);
+	}
+	if (writer->trace != MAP_FAILED)
+		munmap(writer->trace, writer->trace_size);
+	writer->trace = NULL;
+	if (writer->trace_fd >= 0)
+		close(writer->trace_fd);
+	printf("Error: Cannot map the trace file.\n");
+	return (0);
+}
+
+/*
+ * --trace=FILE: the events are not formatted at all, every ring gets a
+ * region of the file and its producer stores fixed size records there
+ * himself. A region starts as room for TRACE_SEAT_RECORDS events per
+ * seat the ring reports for, a whole number of pages, so no two
+ * producers ever write the same page. It is only a start: a long run, or
+ * a worker of the pool that steals more seats than its share, fills it,
+ * and grow_region chains another extent to it then.
+ * Returns 0 if the file cannot be created or mapped, else 1.
+ */
+int	open_trace(t_shared *info)
+{
+	t_writer		*writer;
+	size_t			max;
+	unsigned int	i;
+
+	writer = info->writer;
+	if (!info->opt.trace)
+		return (1);
+	max = TRACE_SEAT_RECORDS;
+	if (info->opt.engine == ENGINE_POOL)
+		max *= info->num_philos / info->opt.workers + 1;
+	writer->trace_size = trace_offset(writer->num_rings)
+		+ sizeof(t_record) * max * writer->num_rings;
+	writer->trace_end = writer->trace_size;
+	if (!map_trace(writer, info->opt.trace))
+		return (0);
+	i = 0;
+	while (i < writer->num_rings)
+	{
+		writer->rings[i].records = (t_record *)(writer->trace
+				+ trace_offset(writer->num_rings)) + max * i;
+		writer->rings[i++].max_records = max;
+	}
+	return (1);
+}
+
+/*
+ * Stores a record in the region, growing it first if it is full. The
+ * record is only counted dropped if the file cannot grow.
+ * Returns 0 if it was dropped, else 1.
+ */
+static int	put_record(t_writer *writer, t_ring *ring, uint32_t delta,
+		uint32_t code)
+{
+	if (ring->num_records == ring->max_records
+		&& !grow_region(writer, ring))
+	{
+		ring->dropped++;
+		return (0);
+	}
+	ring->records[ring->num_records].delta = delta;
+	ring->records[ring->num_records++].code = code;
+	return (1);
+}
+
+/*
+ * The same stop check as push_event, then the time since the previous
+ * record of the region goes in the record, the referee's final line
+ * included. There is no writer to wait for, so no in_flight either:
+ * an event stamped after the referee's last line is dropped by
+ * trace_text like the writer drops it.
+ */
+int	trace_event(t_ring *ring, t_shared *info, unsigned int id, t_state state)
+{
+	time_t	now;
+
+	if (state != DIED && state != ALL_FULL && atomic_load_explicit(
+			&info->stop_epoch, memory_order_acquire) != RUNNING)
+		return (0);
+	now = sim_now(info) - info->sim_start_time;
+	while (now - ring->last_time > UINT32_MAX
+		&& put_record(info->writer, ring, UINT32_MAX, TRACE_SKIP))
+		ring->last_time += UINT32_MAX;
+	if (put_record(info->writer, ring, now - ring->last_time,
+			id << 3 | state))
+		ring->last_time = now;
+	return (1);
+}
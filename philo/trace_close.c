@@ -0,0 +1,135 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_close.c                                      :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 02:25:15 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:33:35 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The records of a region, every extent of it.
+ */
+static size_t	region_records(t_ring *ring)
+{
+	size_t	n;
+	size_t	i;
+
+	n = ring->num_records;
+	i = 0;
+	while (i < ring->num_extents)
+		n += ring->extents[i++].num_records;
+	return (n);
+}
+
+/*
+ * Fills the header and the counts of the regions.
+ */
+static void	write_header(t_shared *info)
+{
+	t_writer		*writer;
+	t_trace_header	*header;
+	unsigned int	i;
+
+	writer = info->writer;
+	header = (t_trace_header *)writer->trace;
+	memcpy(header->magic, TRACE_MAGIC, 8);
+	header->num_regions = writer->num_rings;
+	header->num_meals = info->num_meals;
+	header->dropped = 0;
+	i = 0;
+	while (i < writer->num_rings)
+	{
+		header->dropped += writer->rings[i].dropped;
+		((uint64_t *)(header + 1))[i] = region_records(&writer->rings[i]);
+		i++;
+	}
+}
+
+/*
+ * write(2) until all size bytes are written.
+ * Returns 0 if it fails, else 1.
+ */
+static int	write_all(int fd, const char *buf, size_t size)
+{
+	ssize_t	len;
+
+	while (size)
+	{
+		len = write(fd, buf, size);
+		if (len <= 0)
+			return (0);
+		buf += len;
+		size -= len;
+	}
+	return (1);
+}
+
+/*
+ * Writes the extents of the region in the order they were filled, then
+ * the one in use, unless an earlier write failed, and unmaps the ones
+ * grow_region mapped, the first one is part of the file's mapping.
+ * Returns 0 if a write failed, else 1.
+ */
+static int	write_region(int fd, t_ring *ring, int ok)
+{
+	size_t	i;
+
+	i = 0;
+	while (i < ring->num_extents)
+	{
+		ok = ok && write_all(fd, (char *)ring->extents[i].records,
+				sizeof(t_record) * ring->extents[i].num_records);
+		if (i)
+			munmap(ring->extents[i].records,
+				sizeof(t_record) * ring->extents[i].num_records);
+		i++;
+	}
+	ok = ok && write_all(fd, (char *)ring->records,
+			sizeof(t_record) * ring->num_records);
+	if (ring->num_extents)
+		munmap(ring->records, sizeof(t_record) * ring->max_records);
+	free(ring->extents);
+	return (ok);
+}
+
+/*
+ * Writes the header and every region right after the previous one to a
+ * new file under the same name, so the holes the regions left are gone.
+ * Packing the old file in place is no option, a region that grew has
+ * extents past the ones of the next regions, which packing would
+ * overwrite. The old file goes with its descriptor. Every producer must
+ * be done.
+ */
+void	close_trace(t_shared *info)
+{
+	t_writer		*writer;
+	int				fd;
+	int				ok;
+	unsigned int	i;
+
+	writer = info->writer;
+	if (!writer->trace)
+		return ;
+	write_header(info);
+	unlink(info->opt.trace);
+	fd = open(info->opt.trace, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+	ok = fd >= 0 && write_all(fd, writer->trace,
+			trace_offset(writer->num_rings));
+	i = 0;
+	while (i < writer->num_rings)
+		ok = write_region(fd, &writer->rings[i++], ok);
+	if (!ok)
+		printf("Error: Cannot write the trace file.\n");
+	munmap(writer->trace, writer->trace_size);
+	writer->trace = NULL;
+	pthread_mutex_destroy(&writer->trace_lock);
+	close(writer->trace_fd);
+	if (fd >= 0)
+		close(fd);
+}
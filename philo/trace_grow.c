@@ -0,0 +1,66 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   trace_grow.c                                       :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 04:33:25 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 04:33:25 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Makes the file size bytes longer and maps the new end. The lock only
+ * keeps two producers from taking the same end of the file, or from
+ * cutting it back with an ftruncate of their own.
+ * Returns the mapping, or NULL if the file cannot grow.
+ */
+static t_record	*map_extent(t_writer *writer, size_t size)
+{
+	char	*map;
+
+	map = MAP_FAILED;
+	pthread_mutex_lock(&writer->trace_lock);
+	if (!ftruncate(writer->trace_fd, writer->trace_end + size))
+		map = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED,
+				writer->trace_fd, writer->trace_end);
+	if (map != MAP_FAILED)
+		writer->trace_end += size;
+	pthread_mutex_unlock(&writer->trace_lock);
+	if (map == MAP_FAILED)
+		return (NULL);
+	madvise(map, size, MADV_RANDOM);
+	return ((t_record *)map);
+}
+
+/*
+ * The region of the ring is full: the full extent goes on its chain and
+ * the ring carries on in a new one twice as large, mapped at the end of
+ * the file, so a region only grows a handful of times however long the
+ * run. The extents are whole pages, a producer still never shares a page
+ * with another. close_trace puts the chain back in order.
+ * Returns 0 if malloc or the file fails, else 1.
+ */
+int	grow_region(t_writer *writer, t_ring *ring)
+{
+	t_extent	*extents;
+	t_record	*records;
+
+	extents = realloc(ring->extents, sizeof(t_extent)
+			* (ring->num_extents + 1));
+	if (!extents)
+		return (0);
+	ring->extents = extents;
+	records = map_extent(writer, sizeof(t_record) * ring->max_records * 2);
+	if (!records)
+		return (0);
+	extents[ring->num_extents].records = ring->records;
+	extents[ring->num_extents++].num_records = ring->num_records;
+	ring->records = records;
+	ring->num_records = 0;
+	ring->max_records *= 2;
+	return (1);
+}
@@ -0,0 +1,111 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   virtual_time.c                                     :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:36:52 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:41:22 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * One step of xorshift64, the state is never 0.
+ */
+static unsigned long	next_random(unsigned long *state)
+{
+	*state ^= *state << 13;
+	*state ^= *state >> 7;
+	*state ^= *state << 17;
+	return (*state);
+}
+
+/*
+ * Every seat in the ready queue is ready at the same virtual instant,
+ * with threads the scheduler would decide who goes first. Here a seat is
+ * drawn at random from the queue, so a seed always gives the same run,
+ * and another seed another interleaving of the same instant.
+ */
+static t_philo	*pick_seat(t_worker *worker, unsigned long *state)
+{
+	unsigned int	i;
+	t_philo			*tmp;
+
+	if (worker->ready_len > 1)
+	{
+		i = (worker->ready_head + next_random(state) % worker->ready_len)
+			% worker->ready_cap;
+		tmp = worker->ready[i];
+		worker->ready[i] = worker->ready[worker->ready_head];
+		worker->ready[worker->ready_head] = tmp;
+	}
+	return (pop_ready(worker));
+}
+
+/*
+ * Nothing is ready at the current instant, the clock jumps to the next
+ * thing that happens: the earliest timer, or the earliest deadline of
+ * the monitor heap. A deadline is checked first when both are at the
+ * same time, like the referee sees a philosopher starved at his deadline
+ * exactly. Nothing happens past the horizon, when it is set.
+ */
+static void	advance_clock(t_shared *info, t_worker *worker)
+{
+	t_philo	*root;
+	time_t	next;
+
+	root = info->monitor.heap[0];
+	next = root->deadline;
+	if (worker->num_timers && worker->timers[0]->wake < next)
+		next = worker->timers[0]->wake;
+	if (info->opt.horizon
+		&& info->sim_start_time + info->opt.horizon < next)
+	{
+		info->virtual_now = info->sim_start_time + info->opt.horizon;
+		report_end(info, NULL, TIME_UP);
+		return ;
+	}
+	info->virtual_now = next;
+	publish_clock(info, next - info->sim_start_time);
+	if (next == root->deadline)
+		report_end(info, root, PHILO_DIED);
+	else
+		fire_timers(worker, next);
+}
+
+/*
+ * --virtual-time runs the seats of the pool as a discrete event
+ * simulation, on a single worker driven by the calling thread. Eating,
+ * sleeping and thinking are timers like in the pool, but the clock does
+ * not tick, it jumps from one event to the next, so a run takes as long
+ * as it takes to compute, not time_to_die after time_to_die. The rules
+ * are the ones of the pool, the referee's checks are done between two
+ * instants instead of on a deadline of the real clock.
+ */
+void	run_virtual_time(t_shared *info)
+{
+	t_worker		*worker;
+	t_philo			*philo;
+	unsigned long	state;
+
+	worker = &info->pool->workers[0];
+	state = info->opt.seed * 2654435761UL + 0x9E3779B97F4A7C15UL;
+	if (!state)
+		state = 1;
+	while (!must_simulation_stop(info->table))
+	{
+		if (info->monitor.all_full)
+		{
+			report_end(info, NULL, ALL_PHILOS_FULL);
+			break ;
+		}
+		philo = pick_seat(worker, &state);
+		if (philo)
+			run_seat(worker, philo);
+		else
+			advance_clock(info, worker);
+	}
+}
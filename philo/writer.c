@@ -0,0 +1,146 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   writer.c                                           :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:00:03 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 02:46:37 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * The writer thread, it starts with the simulation. Every millisecond it
+ * takes a watermark, the time since the start from the coarse clock,
+ * which can only be behind the time events are stamped with, collects
+ * the rings and prints everything up to the watermark. After done is set
+ * every philosopher is joined, one last collection gets whatever is
+ * left. In virtual time there is a single producer whose events come in
+ * time order, so there is nothing to wait for and everything collected
+ * is printed. The clock of
+ * --stats-shm is published here too, the virtual clock publishes its own.
+ */
+static void	*writer_routine(void *arg)
+{
+	t_shared	*info;
+	time_t		watermark;
+
+	info = (t_shared *)arg;
+	wait_start_gate(info);
+	while (!atomic_load(&info->writer->done))
+	{
+		watermark = get_coarse_time_us() - info->sim_start_time;
+		if (info->opt.virtual_time)
+			watermark = LONG_MAX;
+		else
+			publish_clock(info, get_time_us() - info->sim_start_time);
+		collect_events(info->writer);
+		emit_events(info->writer, watermark, false);
+		STATS_POLL(info);
+		usleep(1000);
+	}
+	collect_events(info->writer);
+	emit_events(info->writer, 0, true);
+	return (NULL);
+}
+
+/*
+ * Every ring gets its slice of a single block of events. A philosopher
+ * of the thread engine reports a handful of events per meal, a worker of
+ * the pool reports for thousands of seats between two drains, so its
+ * ring is much larger. The referee's ring is the last one.
+ * Returns 0 if malloc fails, else 1.
+ */
+static int	alloc_rings(t_writer *writer, t_shared *info)
+{
+	unsigned int	size;
+	unsigned int	i;
+
+	writer->num_rings = info->num_philos + 1;
+	size = RING_SIZE;
+	if (info->opt.engine == ENGINE_POOL)
+	{
+		writer->num_rings = info->opt.workers + 1;
+		size = WORKER_RING_SIZE;
+	}
+	writer->rings = calloc(writer->num_rings, sizeof(t_ring));
+	writer->events = malloc(sizeof(t_event)
+			* ((size_t)size * (writer->num_rings - 1) + RING_SIZE));
+	if (!writer->rings || !writer->events)
+		return (0);
+	i = 0;
+	while (i < writer->num_rings)
+	{
+		writer->rings[i].events = writer->events + (size_t)size * i;
+		if (i == writer->num_rings - 1)
+			size = RING_SIZE;
+		writer->rings[i++].size = size;
+	}
+	return (1);
+}
+
+/*
+ * Allocates the writer, its rings and the pending events.
+ * Returns 0 if malloc fails, else 1.
+ */
+int	init_writer(t_shared *info)
+{
+	t_writer	*writer;
+
+	writer = calloc(1, sizeof(t_writer));
+	if (!writer)
+	{
+		printf("Error: Malloc failed.\n");
+		return (0);
+	}
+	writer->pending = malloc(sizeof(t_pending) * RING_SIZE);
+	if (!writer->pending || !alloc_rings(writer, info))
+	{
+		free(writer->events);
+		free(writer->rings);
+		free(writer->pending);
+		free(writer);
+		printf("Error: Malloc failed.\n");
+		return (0);
+	}
+	writer->max_pending = RING_SIZE;
+	writer->num_meals = info->num_meals;
+	atomic_init(&writer->done, false);
+	info->writer = writer;
+	return (1);
+}
+
+/*
+ * Creates the writer thread, it must run before any philosopher reports.
+ * Returns 0 if pthread_create fails, else 1.
+ */
+int	start_writer(t_shared *info)
+{
+	if (pthread_create(&info->writer->thread_id, NULL, writer_routine, info))
+	{
+		printf("Error: pthread_create failed.\n");
+		return (0);
+	}
+	return (1);
+}
+
+/*
+ * Sets done, joins the writer once it printed the last line, closes the
+ * trace file and the stats file, and frees the writer. The writer thread
+ * must have been started.
+ */
+void	finish_writer(t_shared *info)
+{
+	atomic_store(&info->writer->done, true);
+	pthread_join(info->writer->thread_id, NULL);
+	close_trace(info);
+	close_stats_shm(info);
+	free(info->writer->pending);
+	free(info->writer->events);
+	free(info->writer->rings);
+	free(info->writer);
+	info->writer = NULL;
+}
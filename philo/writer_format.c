@@ -0,0 +1,143 @@
+/* ************************************************************************** */
+/*                                                                            */
+/*                                                        :::      ::::::::   */
+/*   writer_format.c                                    :+:      :+:    :+:   */
+/*                                                    +:+ +:+         +:+     */
+/*   By: sudaniel <sudaniel@student.42heilbronn.de  +#+  +:+       +#+        */
+/*                                                +#+#+#+#+#+   +#+           */
+/*   Created: 2026/10/18 01:00:03 by sudaniel          #+#    #+#             */
+/*   Updated: 2026/10/18 01:07:54 by sudaniel         ###   ########.fr       */
+/*                                                                            */
+/* ************************************************************************** */
+
+#include "philo.h"
+
+/*
+ * Writes the whole buffer to the standard output, write(2) may take
+ * only part of it when the output is a pipe. On error the batch is lost.
+ */
+static void	flush_output(t_writer *writer)
+{
+	size_t	done;
+	ssize_t	ret;
+
+	done = 0;
+	while (done < writer->len)
+	{
+		ret = write(STDOUT_FILENO, writer->buf + done, writer->len - done);
+		if (ret <= 0)
+			break ;
+		done += ret;
+	}
+	writer->len = 0;
+}
+
+/*
+ * Appends the decimal digits of n to the buffer, the same as printf's
+ * %lu, without going through printf's format parsing.
+ */
+static void	put_number(t_writer *writer, unsigned long n)
+{
+	char	digits[24];
+	int		i;
+
+	i = 0;
+	digits[i++] = '0' + n % 10;
+	n /= 10;
+	while (n)
+	{
+		digits[i++] = '0' + n % 10;
+		n /= 10;
+	}
+	while (i > 0)
+		writer->buf[writer->len++] = digits[--i];
+}
+
+/*
+ * Formats one event as "<time> <philo_id> <state>\n", the time in
+ * milliseconds, or the all full
+ * line, the same text report_philo_state used to printf. The buffer is
+ * flushed first if a line might not fit in it anymore.
+ */
+static void	put_event(t_writer *writer, t_event *event)
+{
+	static const char	*texts[] = {"has taken chopstick.",
+		"has taken a chopstick.", "is eating.", "is sleeping.",
+		"is thinking.", "died."};
+	size_t				len;
+
+	if (writer->len + 128 > OUT_BUF_SIZE)
+		flush_output(writer);
+	if (event->state == ALL_FULL)
+	{
+		memcpy(writer->buf + writer->len, "All philos have eaten ", 22);
+		writer->len += 22;
+		put_number(writer, writer->num_meals);
+		memcpy(writer->buf + writer->len, " meals.\n", 8);
+		writer->len += 8;
+		return ;
+	}
+	put_number(writer, event->time / 1000);
+	writer->buf[writer->len++] = ' ';
+	put_number(writer, event->philo_id);
+	writer->buf[writer->len++] = ' ';
+	len = strlen(texts[event->state]);
+	memcpy(writer->buf + writer->len, texts[event->state], len);
+	writer->len += len;
+	writer->buf[writer->len++] = '\n';
+}
+
+/*
+ * Orders pending events by time, the referee's last line after every
+ * event of the same millisecond, and by drain order otherwise.
+ */
+static int	compare_events(const void *a, const void *b)
+{
+	const t_pending	*x;
+	const t_pending	*y;
+	int				x_last;
+	int				y_last;
+
+	x = (const t_pending *)a;
+	y = (const t_pending *)b;
+	if (x->event.time != y->event.time)
+		return ((x->event.time > y->event.time) - (x->event.time
+				< y->event.time));
+	x_last = (x->event.state == DIED || x->event.state == ALL_FULL);
+	y_last = (y->event.state == DIED || y->event.state == ALL_FULL);
+	if (x_last != y_last)
+		return (x_last - y_last);
+	return ((x->order > y->order) - (x->order < y->order));
+}
+
+/*
+ * Prints the pending events in time order. Before the end only events up
+ * to the watermark are printed, later ones could still be preceded by an
+ * event in flight, and the referee's last line is held back. When final
+ * is true every producer is done, so everything up to the last line is
+ * printed and whatever came after it is dropped.
+ */
+void	emit_events(t_writer *writer, time_t watermark, bool final)
+{
+	size_t	i;
+	t_event	*event;
+
+	qsort(writer->pending, writer->num_pending, sizeof(t_pending),
+		compare_events);
+	i = 0;
+	while (i < writer->num_pending)
+	{
+		event = &writer->pending[i].event;
+		if (!final && (event->time > watermark || event->state == DIED
+				|| event->state == ALL_FULL))
+			break ;
+		put_event(writer, event);
+		i++;
+		if (event->state == DIED || event->state == ALL_FULL)
+			i = writer->num_pending;
+	}
+	writer->num_pending -= i;
+	memmove(writer->pending, writer->pending + i,
+		sizeof(t_pending) * writer->num_pending);
+	flush_output(writer);
+}